@@ -0,0 +1,326 @@
+// Bench.cpp : times the provers on generated problems and compares the results to a stored baseline
+//
+
+#include "stdafx.h"
+#include "Generators.h"
+#include "Prover.h"
+#include "CommandLine.h"
+
+#if defined(_WIN32)
+#define NOMINMAX
+#include <windows.h>
+#include <psapi.h>
+#if defined(_MSC_VER)
+#pragma comment(lib, "psapi.lib")
+#endif
+#else
+#include <sys/resource.h>
+#endif
+
+using namespace std;
+
+// One benchmark problem. Expected is 1 if it is unsatisfiable (the query is valid), 0 if it is satisfiable, and
+// -1 if either answer is fine, as for random instances.
+struct BenchCase
+{
+public:
+  string name;
+  function<int(ClauseDatabase&)> generate;
+  int expected;
+};
+
+struct BenchResult
+{
+public:
+  string name;
+  string answer;
+  double seconds;
+  int clauses;
+  size_t peakRss;
+};
+
+// The process's peak resident set size in bytes, or 0 where it cannot be read
+size_t PeakRss()
+{
+#if defined(_WIN32)
+  PROCESS_MEMORY_COUNTERS counters;
+  if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+    return 0;
+  return counters.PeakWorkingSetSize;
+#elif defined(__linux__)
+  ifstream status("/proc/self/status");
+  string line;
+  while (getline(status, line))
+  {
+    if (line.compare(0, 6, "VmHWM:") == 0)
+      return (size_t)atol(line.c_str() + 6) * 1024;
+  }
+  return 0;
+#else
+  // Kilobytes everywhere but on macOS
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+#if defined(__APPLE__)
+  return (size_t)usage.ru_maxrss;
+#else
+  return (size_t)usage.ru_maxrss * 1024;
+#endif
+#endif
+}
+
+// Starts a new peak, so each case reports its own. Only Linux can do this; elsewhere the peak is the largest so
+// far, and the cases run roughly smallest first to keep that meaningful.
+void ResetPeakRss()
+{
+#if defined(__linux__)
+  ofstream clear("/proc/self/clear_refs");
+  clear << "5";
+#endif
+}
+
+vector<BenchCase> Suite()
+{
+  vector<BenchCase> suite;
+
+  for (int length : { 1000, 10000, 100000 })
+    suite.push_back({ "chain-" + to_string(length), [length](ClauseDatabase& db) { return ImplicationChain(length, db); }, 1 });
+
+  for (int exchangers : { 2, 16, 128, 1024, 8192 })
+    suite.push_back({ "plant-" + to_string(exchangers), [exchangers](ClauseDatabase& db) { return PowerPlant(exchangers, db); }, 1 });
+
+  for (int holes : { 3, 4 })
+    suite.push_back({ "php-" + to_string(holes), [holes](ClauseDatabase& db) { return Pigeonhole(holes, db); }, 1 });
+
+  for (int vars : { 20, 30, 40 })
+  {
+    for (unsigned seed = 1; seed <= 3; seed++)
+    {
+      suite.push_back({ "rnd3-" + to_string(vars) + "-" + to_string(seed),
+        [vars, seed](ClauseDatabase& db) { return Random3Cnf(vars, 4.26, seed, db); }, -1 });
+    }
+  }
+
+  return suite;
+}
+
+// Proves one case repeat times with options, and keeps the fastest run
+BenchResult RunCase(const BenchCase& benchCase, const ProverOptions& options, int repeat)
+{
+  BenchResult result;
+  result.name = benchCase.name;
+  result.seconds = 0;
+
+  for (int r = 0; r < max(1, repeat); r++)
+  {
+    // Generating the problem is not part of the time
+    ClauseDatabase db;
+    ProverOptions caseOptions = options;
+    caseOptions.queryClauses = benchCase.generate(db);
+
+    ResetPeakRss();
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    int falseClause = MakeProver(caseOptions)->Prove(db);
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    if (r == 0 || seconds < result.seconds)
+      result.seconds = seconds;
+    result.clauses = db.Size();
+    result.peakRss = PeakRss();
+    result.answer = falseClause >= 0 ? "unsat" : falseClause == UnknownResult ? "unknown" : "sat";
+  }
+
+  return result;
+}
+
+// Proves every case that passes the filter with 1, 2, 4 ... up to maxThreads threads, and prints each time and
+// its speedup over one thread. Returns 1 if the thread count changed an answer.
+int Scaling(const vector<BenchCase>& suite, const string& filter, ProverOptions options, int repeat, int maxThreads)
+{
+  vector<int> counts;
+  for (int threads = 1; threads <= maxThreads; threads *= 2)
+    counts.push_back(threads);
+
+  cout << left << setw(14) << "case" << setw(8) << "answer" << right;
+  for (int x = 0; x < counts.size(); x++)
+    cout << setw(12) << to_string(counts[x]) + " thr" << setw(8) << "speedup";
+  cout << endl;
+
+  bool failed = false;
+  for (int c = 0; c < suite.size(); c++)
+  {
+    if (suite[c].name.find(filter) == string::npos)
+      continue;
+
+    string answer;
+    double single = 0;
+    for (int x = 0; x < counts.size(); x++)
+    {
+      options.threads = counts[x];
+      BenchResult result = RunCase(suite[c], options, repeat);
+      if (x == 0)
+      {
+        answer = result.answer;
+        single = result.seconds;
+        cout << left << setw(14) << result.name << setw(8) << result.answer << right;
+      }
+      else if (result.answer != answer)
+      {
+        cerr << result.name << ": " << counts[x] << " threads answered " << result.answer << endl;
+        failed = true;
+      }
+
+      cout << fixed << setprecision(3) << setw(12) << result.seconds << setprecision(2) << setw(7)
+        << (result.seconds > 0 ? single / result.seconds : 1) << "x";
+    }
+    cout << endl;
+  }
+
+  return failed ? 1 : 0;
+}
+
+// A baseline file has one "name answer seconds clauses" line per case; lines starting with '#' are comments
+unordered_map<string, BenchResult> ReadBaseline(const string& fileName)
+{
+  unordered_map<string, BenchResult> baseline;
+  ifstream input(fileName);
+  string line;
+  while (getline(input, line))
+  {
+    if (line.empty() || line[0] == '#')
+      continue;
+
+    BenchResult result;
+    istringstream fields(line);
+    if (fields >> result.name >> result.answer >> result.seconds >> result.clauses)
+      baseline[result.name] = result;
+  }
+  return baseline;
+}
+
+bool WriteBaseline(const string& fileName, const vector<BenchResult>& results)
+{
+  ofstream output(fileName);
+  if (!output)
+    return false;
+
+  output << "# name answer seconds clauses" << endl;
+  for (int x = 0; x < results.size(); x++)
+    output << results[x].name << " " << results[x].answer << " " << results[x].seconds << " " << results[x].clauses << endl;
+  return true;
+}
+
+int main(int argc, char *argv[])
+{
+  // Switches:
+  //   --engine=E, --threads=N, --bitset=0, --binary=0, --preprocess=0, --strategy=S, --order=O
+  //               prove with these settings, as for the prover
+  //   --filter=S  only run the cases whose name contains S
+  //   --repeat=N  run every case N times and keep the fastest (default 5, as the stored baseline was recorded)
+  //   --baseline=F
+  //               compare against the results saved in F, and fail if a case got slower by more than the
+  //               tolerance or gave a wrong answer
+  //   --tolerance=P
+  //               slowdown allowed against the baseline, in percent (default 25)
+  //   --save=F    save the results to F as a new baseline
+  //   --scaling=N run the cases with 1, 2, 4 ... up to N threads instead, and print the speedup over one thread
+  ProverOptions options;
+  string filter = "";
+  string baselineFile = "";
+  string saveFile = "";
+  int repeat = 5;
+  int tolerance = 25;
+  int scaling = 0;
+
+  for (int x = 1; x < argc; x++)
+  {
+    string arg = argv[x];
+    if (ReadOption(arg, "engine", options.engine) || ReadOption(arg, "threads", options.threads) || ReadOption(arg, "bitset", options.bitsets))
+      continue;
+    if (ReadOption(arg, "strategy", options.strategy) || ReadOption(arg, "order", options.order) || ReadOption(arg, "binary", options.binaryGraph))
+      continue;
+    if (ReadOption(arg, "preprocess", options.preprocess))
+      continue;
+    if (ReadOption(arg, "filter", filter) || ReadOption(arg, "repeat", repeat) || ReadOption(arg, "tolerance", tolerance))
+      continue;
+    if (ReadOption(arg, "baseline", baselineFile) || ReadOption(arg, "save", saveFile) || ReadOption(arg, "scaling", scaling))
+      continue;
+
+    cerr << "Unknown argument " << arg << endl;
+    return 1;
+  }
+
+  if (!MakeProver(options))
+  {
+    cerr << "Unknown engine " << options.engine << endl;
+    return 1;
+  }
+  if (!IsStrategy(options.strategy))
+  {
+    cerr << "Unknown strategy " << options.strategy << endl;
+    return 1;
+  }
+
+  vector<BenchCase> suite = Suite();
+  if (scaling > 0)
+    return Scaling(suite, filter, options, repeat, scaling);
+
+  unordered_map<string, BenchResult> baseline;
+  if (!baselineFile.empty())
+    baseline = ReadBaseline(baselineFile);
+
+  vector<BenchResult> results;
+  bool failed = false;
+
+  cout << left << setw(14) << "case" << setw(8) << "answer" << right << setw(10) << "seconds" << setw(10) << "clauses"
+    << setw(10) << "peak MB" << "  baseline" << endl;
+
+  for (int c = 0; c < suite.size(); c++)
+  {
+    if (suite[c].name.find(filter) == string::npos)
+      continue;
+
+    BenchResult result = RunCase(suite[c], options, repeat);
+
+    cout << left << setw(14) << result.name << setw(8) << result.answer << right << fixed << setprecision(3)
+      << setw(10) << result.seconds << setw(10) << result.clauses << setprecision(1) << setw(10) << result.peakRss / 1048576.0;
+
+    if (suite[c].expected >= 0 && result.answer != (suite[c].expected == 1 ? "unsat" : "sat"))
+    {
+      cout << "  WRONG ANSWER";
+      failed = true;
+    }
+
+    auto old = baseline.find(result.name);
+    if (old != baseline.end())
+    {
+      // The random cases have no expected answer, but they must not change it
+      if (result.answer != old->second.answer && result.answer != "unknown" && old->second.answer != "unknown")
+      {
+        cout << "  WRONG ANSWER, baseline " << old->second.answer;
+        failed = true;
+      }
+
+      // Runs under 50 ms are mostly noise, so they never count as slower
+      double ratio = old->second.seconds > 0 ? result.seconds / old->second.seconds : 1;
+      cout << "  " << setprecision(2) << ratio << "x time";
+      if (ratio > 1 + tolerance / 100.0 && result.seconds > 0.05)
+      {
+        cout << " SLOWER";
+        failed = true;
+      }
+      if (result.clauses != old->second.clauses)
+        cout << ", clauses " << old->second.clauses << " -> " << result.clauses;
+    }
+    cout << endl;
+
+    results.push_back(result);
+  }
+
+  if (!saveFile.empty() && !WriteBaseline(saveFile, results))
+  {
+    cerr << saveFile << ": cannot create file" << endl;
+    return 1;
+  }
+
+  return failed ? 1 : 0;
+}
@@ -0,0 +1,322 @@
+// BitClause.h : fixed-width bitset clauses for knowledge bases with few atoms
+//
+
+#pragma once
+
+#include "ClauseDatabase.h"
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#if defined(__AVX2__) || defined(__SSE2__) || defined(_M_X64)
+#include <immintrin.h>
+#endif
+
+inline int PopCount(uint64_t x)
+{
+#if defined(_MSC_VER) && defined(_M_X64)
+  return (int)__popcnt64(x);
+#elif defined(__GNUC__)
+  return __builtin_popcountll(x);
+#else
+  int count = 0;
+  for (; x != 0; x &= x - 1)
+    count++;
+  return count;
+#endif
+}
+
+// Index of the lowest set bit of x, which must not be zero
+inline int LowestBit(uint64_t x)
+{
+#if defined(_MSC_VER) && defined(_M_X64)
+  unsigned long index;
+  _BitScanForward64(&index, x);
+  return (int)index;
+#elif defined(__GNUC__)
+  return __builtin_ctzll(x);
+#else
+  int index = 0;
+  for (; (x & 1) == 0; x >>= 1)
+    index++;
+  return index;
+#endif
+}
+
+// A clause over at most Atoms atoms, stored as one bit per atom for the positive literals and one for the
+// negative ones. Atoms must be a multiple of 64.
+template <int Atoms>
+struct BitClause
+{
+public:
+  static const int Words = Atoms / 64;
+
+  uint64_t pos[Words];
+  uint64_t neg[Words];
+
+  void Assign(const Literal* begin, const Literal* end)
+  {
+    for (int x = 0; x < Words; x++)
+    {
+      pos[x] = 0;
+      neg[x] = 0;
+    }
+
+    for (const Literal* l = begin; l != end; l++)
+    {
+      uint64_t bit = 1ull << (AtomOf(*l) & 63);
+      if (IsNegated(*l))
+        neg[AtomOf(*l) >> 6] |= bit;
+      else
+        pos[AtomOf(*l) >> 6] |= bit;
+    }
+  }
+
+  // Writes the literals back out in the database's sorted order
+  void ToLiterals(std::vector<Literal>& lits) const
+  {
+    lits.clear();
+    for (int x = 0; x < Words; x++)
+    {
+      for (uint64_t m = pos[x] | neg[x]; m != 0; m &= m - 1)
+      {
+        int atom = x * 64 + LowestBit(m);
+        uint64_t bit = 1ull << (atom & 63);
+        if (pos[x] & bit)
+          lits.push_back(MakeLiteral(atom, false));
+        if (neg[x] & bit)
+          lits.push_back(MakeLiteral(atom, true));
+      }
+    }
+  }
+};
+
+// Portable kernels. The wider specializations below replace them with SSE2 or AVX2 when the compiler targets it.
+// The vector loads are unaligned, so a BitClause can live anywhere, including inside a std::vector.
+
+// The atoms a and b clash on, as a bit mask. Returns the number of them, stopping early once it passes one.
+template <int Atoms>
+inline int ClashMask(const BitClause<Atoms>& a, const BitClause<Atoms>& b, uint64_t* mask)
+{
+  int clashes = 0;
+  for (int x = 0; x < BitClause<Atoms>::Words; x++)
+  {
+    mask[x] = (a.pos[x] & b.neg[x]) | (a.neg[x] & b.pos[x]);
+    clashes += PopCount(mask[x]);
+    if (clashes > 1)
+      return clashes;
+  }
+  return clashes;
+}
+
+// Resolves a and b, which must clash on exactly the one atom in mask
+template <int Atoms>
+inline void CombineWithout(const BitClause<Atoms>& a, const BitClause<Atoms>& b, const uint64_t* mask, BitClause<Atoms>& out)
+{
+  for (int x = 0; x < BitClause<Atoms>::Words; x++)
+  {
+    out.pos[x] = (a.pos[x] | b.pos[x]) & ~mask[x];
+    out.neg[x] = (a.neg[x] | b.neg[x]) & ~mask[x];
+  }
+}
+
+template <int Atoms>
+inline bool IsTautology(const BitClause<Atoms>& a)
+{
+  for (int x = 0; x < BitClause<Atoms>::Words; x++)
+  {
+    if (a.pos[x] & a.neg[x])
+      return true;
+  }
+  return false;
+}
+
+// Finds if every literal of a is also in b
+template <int Atoms>
+inline bool IsSubset(const BitClause<Atoms>& a, const BitClause<Atoms>& b)
+{
+  for (int x = 0; x < BitClause<Atoms>::Words; x++)
+  {
+    if ((a.pos[x] & ~b.pos[x]) | (a.neg[x] & ~b.neg[x]))
+      return false;
+  }
+  return true;
+}
+
+#if defined(__SSE2__) || defined(_M_X64)
+
+template <>
+inline int ClashMask<128>(const BitClause<128>& a, const BitClause<128>& b, uint64_t* mask)
+{
+  __m128i ap = _mm_loadu_si128((const __m128i*)a.pos);
+  __m128i an = _mm_loadu_si128((const __m128i*)a.neg);
+  __m128i bp = _mm_loadu_si128((const __m128i*)b.pos);
+  __m128i bn = _mm_loadu_si128((const __m128i*)b.neg);
+  _mm_storeu_si128((__m128i*)mask, _mm_or_si128(_mm_and_si128(ap, bn), _mm_and_si128(an, bp)));
+  return PopCount(mask[0]) + PopCount(mask[1]);
+}
+
+template <>
+inline void CombineWithout<128>(const BitClause<128>& a, const BitClause<128>& b, const uint64_t* mask, BitClause<128>& out)
+{
+  __m128i m = _mm_loadu_si128((const __m128i*)mask);
+  __m128i p = _mm_or_si128(_mm_loadu_si128((const __m128i*)a.pos), _mm_loadu_si128((const __m128i*)b.pos));
+  __m128i n = _mm_or_si128(_mm_loadu_si128((const __m128i*)a.neg), _mm_loadu_si128((const __m128i*)b.neg));
+  _mm_storeu_si128((__m128i*)out.pos, _mm_andnot_si128(m, p));
+  _mm_storeu_si128((__m128i*)out.neg, _mm_andnot_si128(m, n));
+}
+
+#endif
+
+#if defined(__AVX2__)
+
+// One 256-bit lane covers four words, so the 256 and 512 atom widths take one and two lanes per sign
+template <int Atoms>
+inline int ClashMaskAvx2(const BitClause<Atoms>& a, const BitClause<Atoms>& b, uint64_t* mask)
+{
+  int clashes = 0;
+  for (int x = 0; x < BitClause<Atoms>::Words; x += 4)
+  {
+    __m256i ap = _mm256_loadu_si256((const __m256i*)(a.pos + x));
+    __m256i an = _mm256_loadu_si256((const __m256i*)(a.neg + x));
+    __m256i bp = _mm256_loadu_si256((const __m256i*)(b.pos + x));
+    __m256i bn = _mm256_loadu_si256((const __m256i*)(b.neg + x));
+    __m256i m = _mm256_or_si256(_mm256_and_si256(ap, bn), _mm256_and_si256(an, bp));
+    _mm256_storeu_si256((__m256i*)(mask + x), m);
+
+    if (!_mm256_testz_si256(m, m))
+    {
+      clashes += PopCount(mask[x]) + PopCount(mask[x + 1]) + PopCount(mask[x + 2]) + PopCount(mask[x + 3]);
+      if (clashes > 1)
+        return clashes;
+    }
+  }
+  return clashes;
+}
+
+template <int Atoms>
+inline void CombineWithoutAvx2(const BitClause<Atoms>& a, const BitClause<Atoms>& b, const uint64_t* mask, BitClause<Atoms>& out)
+{
+  for (int x = 0; x < BitClause<Atoms>::Words; x += 4)
+  {
+    __m256i m = _mm256_loadu_si256((const __m256i*)(mask + x));
+    __m256i p = _mm256_or_si256(_mm256_loadu_si256((const __m256i*)(a.pos + x)), _mm256_loadu_si256((const __m256i*)(b.pos + x)));
+    __m256i n = _mm256_or_si256(_mm256_loadu_si256((const __m256i*)(a.neg + x)), _mm256_loadu_si256((const __m256i*)(b.neg + x)));
+    _mm256_storeu_si256((__m256i*)(out.pos + x), _mm256_andnot_si256(m, p));
+    _mm256_storeu_si256((__m256i*)(out.neg + x), _mm256_andnot_si256(m, n));
+  }
+}
+
+template <int Atoms>
+inline bool IsSubsetAvx2(const BitClause<Atoms>& a, const BitClause<Atoms>& b)
+{
+  for (int x = 0; x < BitClause<Atoms>::Words; x += 4)
+  {
+    __m256i p = _mm256_andnot_si256(_mm256_loadu_si256((const __m256i*)(b.pos + x)), _mm256_loadu_si256((const __m256i*)(a.pos + x)));
+    __m256i n = _mm256_andnot_si256(_mm256_loadu_si256((const __m256i*)(b.neg + x)), _mm256_loadu_si256((const __m256i*)(a.neg + x)));
+    __m256i extra = _mm256_or_si256(p, n);
+    if (!_mm256_testz_si256(extra, extra))
+      return false;
+  }
+  return true;
+}
+
+template <>
+inline int ClashMask<256>(const BitClause<256>& a, const BitClause<256>& b, uint64_t* mask) { return ClashMaskAvx2(a, b, mask); }
+template <>
+inline int ClashMask<512>(const BitClause<512>& a, const BitClause<512>& b, uint64_t* mask) { return ClashMaskAvx2(a, b, mask); }
+
+template <>
+inline void CombineWithout<256>(const BitClause<256>& a, const BitClause<256>& b, const uint64_t* mask, BitClause<256>& out) { CombineWithoutAvx2(a, b, mask, out); }
+template <>
+inline void CombineWithout<512>(const BitClause<512>& a, const BitClause<512>& b, const uint64_t* mask, BitClause<512>& out) { CombineWithoutAvx2(a, b, mask, out); }
+
+template <>
+inline bool IsSubset<256>(const BitClause<256>& a, const BitClause<256>& b) { return IsSubsetAvx2(a, b); }
+template <>
+inline bool IsSubset<512>(const BitClause<512>& a, const BitClause<512>& b) { return IsSubsetAvx2(a, b); }
+
+#endif
+
+// Resolution kernel working directly on the database's sorted literal arrays. Used when there are too many
+// atoms for a bitset.
+struct SortedKernel
+{
+public:
+  const ClauseDatabase& db;
+
+  SortedKernel(const ClauseDatabase& database) : db(database) {}
+
+  bool Resolve(int a, int b, std::vector<Literal>& resolvent) { return db.Resolve(a, b, resolvent); }
+
+  bool IsTautology(int id)
+  {
+    for (const Literal* l = db.Begin(id) + 1; l < db.End(id); l++)
+    {
+      if (*l == Complement(l[-1]))
+        return true;
+    }
+    return false;
+  }
+
+  bool Subsumes(int a, int b)
+  {
+    return ClauseDatabase::IsSubset(db.Begin(a), db.End(a), db.Begin(b), db.End(b));
+  }
+
+  void Sync() {}
+  void Reset() {}
+};
+
+// Resolution kernel that keeps a BitClause copy of every clause in the database, so the clash test, the
+// resolvent and the subset test are a few word operations per pair. Only valid while the atom count is at
+// most Atoms.
+template <int Atoms>
+struct BitsetKernel
+{
+public:
+  const ClauseDatabase& db;
+  std::vector<BitClause<Atoms>> bits;
+
+  BitsetKernel(const ClauseDatabase& database) : db(database) {}
+
+  bool Resolve(int a, int b, std::vector<Literal>& resolvent)
+  {
+    Sync();
+
+    uint64_t mask[BitClause<Atoms>::Words];
+    if (ClashMask(bits[a], bits[b], mask) != 1)
+      return false;
+
+    BitClause<Atoms> result;
+    CombineWithout(bits[a], bits[b], mask, result);
+    result.ToLiterals(resolvent);
+    return true;
+  }
+
+  bool IsTautology(int id)
+  {
+    Sync();
+    return ::IsTautology(bits[id]);
+  }
+
+  bool Subsumes(int a, int b)
+  {
+    Sync();
+    return IsSubset(bits[a], bits[b]);
+  }
+
+  // Mirrors every clause added to the database since the last call. The other members call it themselves; it
+  // only needs calling directly before several threads share the kernel, after which they only read it.
+  void Sync()
+  {
+    for (int x = (int)bits.size(); x < db.Size(); x++)
+    {
+      bits.emplace_back();
+      bits.back().Assign(db.Begin(x), db.End(x));
+    }
+  }
+
+  // Forgets the copies, for when the database has renumbered its clauses
+  void Reset() { bits.clear(); }
+};
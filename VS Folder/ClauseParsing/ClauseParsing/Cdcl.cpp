@@ -0,0 +1,565 @@
+// Cdcl.cpp : conflict-driven clause learning engine
+//
+
+#include "stdafx.h"
+#include "Cdcl.h"
+
+using namespace std;
+
+CdclProver::CdclProver(const ProverOptions& opts)
+  : options(opts), db(NULL)
+{
+}
+
+int CdclProver::Prove(ClauseDatabase& database)
+{
+  Reset(database);
+  model.clear();
+
+  // Support does not matter here, since the search has no set of support
+  vector<int> ids(db->Size());
+  for (int x = 0; x < ids.size(); x++)
+    ids[x] = x;
+  vector<bool> support(ids.size(), false);
+
+  Preprocessor pre(*db);
+  if (options.preprocess)
+  {
+    int conflict = pre.Simplify(ids, support, SimplificationBudget(*db), stats);
+    if (conflict >= 0)
+      return conflict;
+  }
+
+  vector<int> unitInputs;
+
+  for (int i = 0; i < ids.size(); i++)
+  {
+    int x = ids[i];
+    if (db->Length(x) == 0)
+      return x;
+
+    // A tautology is true in every model and can never help to derive False
+    bool tautology = false;
+    for (const Literal* l = db->Begin(x) + 1; l < db->End(x); l++)
+      tautology = tautology || *l == Complement(l[-1]);
+    if (tautology)
+      continue;
+
+    int index = AddClause(x, db->Begin(x), db->End(x), false);
+    if (db->Length(x) == 1)
+      unitInputs.push_back(index);
+  }
+
+  for (int x = 0; x < unitInputs.size(); x++)
+  {
+    const Clause& c = clauses[unitInputs[x]];
+    Literal l = lits[c.offset];
+
+    // Two contradicting unit inputs resolve straight to False
+    if (Value(l) == -1)
+      return Resolve(c.id, clauses[reasons[AtomOf(l)]].id);
+    if (Value(l) == 0)
+      Assign(l, unitInputs[x]);
+  }
+
+  int conflictsToRestart = 100 * Luby(0);
+  ProgressClock progress(options.progress);
+
+  while (true)
+  {
+    int conflict = Propagate();
+
+    if (conflict >= 0)
+    {
+      stats.conflicts++;
+      if (Level() == 0)
+        return StripLevelZero(clauses[conflict].id);
+
+      int backjump;
+      int learned = Analyze(conflict, backjump);
+      Backtrack(backjump);
+
+      const Literal* begin = db->Begin(learned);
+      const Literal* end = db->End(learned);
+
+      // Watch the asserting literal and a literal from the backjump level, so the clause is correctly
+      // watched once the search comes back above that level
+      scratch.assign(begin, end);
+      for (int x = 0; x < scratch.size(); x++)
+      {
+        if (Value(scratch[x]) == 0)
+          swap(scratch[0], scratch[x]);
+      }
+      for (int x = 2; x < scratch.size(); x++)
+      {
+        if (levels[AtomOf(scratch[x])] > levels[AtomOf(scratch[1])])
+          swap(scratch[1], scratch[x]);
+      }
+
+      int index = AddClause(learned, scratch.data(), scratch.data() + scratch.size(), true);
+      learnedCount++;
+      BumpClause(index);
+      Assign(scratch[0], index);
+
+      increment /= 0.95;
+      clauseIncrement /= 0.999f;
+
+      if (--conflictsToRestart <= 0)
+      {
+        stats.restarts++;
+        conflictsToRestart = 100 * Luby((int)stats.restarts);
+        Backtrack(0);
+
+        if (progress.Due())
+          stats.WriteProgress(cerr, *db);
+      }
+      continue;
+    }
+
+    if (learnedCount - (int)trail.size() >= maxLearned)
+      ReduceLearned();
+
+    Literal next = Decide();
+    if (next == (Literal)-1)
+    {
+      // Every atom has a value, so the trail is a model of the simplified clauses, and the preprocessor turns it
+      // into one of the clauses it was given
+      model.resize(levels.size());
+      for (int x = 0; x < model.size(); x++)
+        model[x] = Value(MakeLiteral(x, false));
+      pre.Extend(model);
+      return -1;
+    }
+
+    stats.decisions++;
+    trailLimits.push_back(trail.size());
+    Assign(next, -1);
+  }
+}
+
+void CdclProver::Reset(ClauseDatabase& database)
+{
+  db = &database;
+  size_t atoms = db->atoms.names.size();
+
+  lits.clear();
+  clauses.clear();
+  watches.assign(2 * atoms, vector<int>());
+  wasted = 0;
+
+  values.assign(2 * atoms, 0);
+  levels.assign(atoms, 0);
+  reasons.assign(atoms, -1);
+  phases.assign(atoms, true);
+
+  trail.clear();
+  trailLimits.clear();
+  head = 0;
+
+  units.assign(atoms, -1);
+  unitsDone = 0;
+
+  activity.assign(atoms, 0.0);
+  increment = 1.0;
+  heap.clear();
+  heapIndex.assign(atoms, -1);
+  for (int x = 0; x < atoms; x++)
+    HeapInsert(x);
+
+  clauseIncrement = 1.0f;
+  learnedCount = 0;
+  maxLearned = max(1000.0, db->Size() / 3.0);
+
+  marks.assign(atoms, false);
+}
+
+int CdclProver::AddClause(int id, const Literal* begin, const Literal* end, bool learned)
+{
+  Clause c;
+  c.offset = (uint32_t)lits.size();
+  c.length = (uint32_t)(end - begin);
+  c.id = id;
+  c.activity = 0.0f;
+  c.learned = learned;
+  c.deleted = false;
+
+  lits.insert(lits.end(), begin, end);
+  clauses.push_back(c);
+
+  int index = (int)clauses.size() - 1;
+  if (c.length >= 2)
+  {
+    watches[begin[0]].push_back(index);
+    watches[begin[1]].push_back(index);
+  }
+  return index;
+}
+
+void CdclProver::Assign(Literal l, int reason)
+{
+  int atom = AtomOf(l);
+  values[l] = 1;
+  values[Complement(l)] = -1;
+  levels[atom] = Level();
+  reasons[atom] = reason;
+  trail.push_back(l);
+}
+
+int CdclProver::Propagate()
+{
+  while (head < trail.size())
+  {
+    Literal f = Complement(trail[head++]);
+    vector<int>& list = watches[f];
+
+    size_t keep = 0;
+    for (size_t x = 0; x < list.size(); x++)
+    {
+      int index = list[x];
+      Clause& c = clauses[index];
+
+      // Deleted clauses leave the watch lists as they are come across
+      if (c.deleted)
+        continue;
+
+      Literal* w = &lits[c.offset];
+
+      // Keep the literal that just became false in w[1]
+      if (w[0] == f)
+        swap(w[0], w[1]);
+
+      if (Value(w[0]) == 1)
+      {
+        list[keep++] = index;
+        continue;
+      }
+
+      // Look for another literal to watch in place of the false one
+      bool moved = false;
+      for (uint32_t k = 2; k < c.length; k++)
+      {
+        if (Value(w[k]) != -1)
+        {
+          swap(w[1], w[k]);
+          watches[w[1]].push_back(index);
+          moved = true;
+          break;
+        }
+      }
+
+      if (moved)
+        continue;
+
+      list[keep++] = index;
+
+      if (Value(w[0]) == -1)
+      {
+        // Leave the rest of the list as it was
+        for (x++; x < list.size(); x++)
+          list[keep++] = list[x];
+        list.resize(keep);
+        return index;
+      }
+
+      Assign(w[0], index);
+    }
+
+    list.resize(keep);
+  }
+
+  return -1;
+}
+
+int CdclProver::Analyze(int conflict, int& backjump)
+{
+  int level = Level();
+  int current = clauses[conflict].id;
+  if (clauses[conflict].learned)
+    BumpClause(conflict);
+
+  // Count the literals of the current level still to be resolved away; the first unique implication point is
+  // reached when only one is left
+  int open = 0;
+  for (const Literal* l = db->Begin(current); l != db->End(current); l++)
+  {
+    int atom = AtomOf(*l);
+    if (levels[atom] > 0)
+      BumpAtom(atom);
+    if (levels[atom] == level && !marks[atom])
+    {
+      marks[atom] = true;
+      open++;
+    }
+  }
+
+  size_t x = trail.size();
+  while (true)
+  {
+    do
+      x--;
+    while (!marks[AtomOf(trail[x])]);
+
+    int atom = AtomOf(trail[x]);
+    marks[atom] = false;
+    if (--open == 0)
+      break;
+
+    int reason = reasons[atom];
+    if (clauses[reason].learned)
+      BumpClause(reason);
+
+    current = Resolve(current, clauses[reason].id);
+
+    for (const Literal* l = db->Begin(clauses[reason].id); l != db->End(clauses[reason].id); l++)
+    {
+      int other = AtomOf(*l);
+      if (other == atom)
+        continue;
+      if (levels[other] > 0)
+        BumpAtom(other);
+      if (levels[other] == level && !marks[other])
+      {
+        marks[other] = true;
+        open++;
+      }
+    }
+  }
+
+  current = StripLevelZero(current);
+
+  backjump = 0;
+  for (const Literal* l = db->Begin(current); l != db->End(current); l++)
+  {
+    int atomLevel = levels[AtomOf(*l)];
+    if (atomLevel < level)
+      backjump = max(backjump, atomLevel);
+  }
+  return current;
+}
+
+int CdclProver::StripLevelZero(int id)
+{
+  DeriveUnits();
+
+  // Copy the literals out, since adding the intermediate clauses can move the pool
+  scratch.assign(db->Begin(id), db->End(id));
+
+  int current = id;
+  for (int x = 0; x < scratch.size(); x++)
+  {
+    int atom = AtomOf(scratch[x]);
+    if (Value(scratch[x]) == -1 && levels[atom] == 0)
+      current = Resolve(current, units[atom]);
+  }
+  return current;
+}
+
+void CdclProver::DeriveUnits()
+{
+  size_t levelZero = trailLimits.empty() ? trail.size() : trailLimits[0];
+
+  // Each level 0 literal's reason has every other literal false at level 0 and earlier on the trail, so one pass
+  // in trail order finds all the units a reason needs already derived
+  for (; unitsDone < levelZero; unitsDone++)
+  {
+    int atom = AtomOf(trail[unitsDone]);
+    int id = clauses[reasons[atom]].id;
+
+    vector<Literal> others(db->Begin(id), db->End(id));
+    for (int x = 0; x < others.size(); x++)
+    {
+      if (AtomOf(others[x]) != atom)
+        id = Resolve(id, units[AtomOf(others[x])]);
+    }
+    units[atom] = id;
+  }
+}
+
+int CdclProver::Resolve(int a, int b)
+{
+  db->Resolve(a, b, resolvent);
+  return db->Add(resolvent, a, b);
+}
+
+void CdclProver::Backtrack(int level)
+{
+  if (Level() <= level)
+    return;
+
+  for (size_t x = trail.size(); x-- > trailLimits[level]; )
+  {
+    Literal l = trail[x];
+    int atom = AtomOf(l);
+    values[l] = 0;
+    values[Complement(l)] = 0;
+    reasons[atom] = -1;
+    phases[atom] = IsNegated(l);
+    if (heapIndex[atom] < 0)
+      HeapInsert(atom);
+  }
+
+  trail.resize(trailLimits[level]);
+  trailLimits.resize(level);
+  head = trail.size();
+}
+
+Literal CdclProver::Decide()
+{
+  while (!heap.empty())
+  {
+    int atom = HeapPop();
+    if (Value(MakeLiteral(atom, false)) == 0)
+      return MakeLiteral(atom, phases[atom]);
+  }
+  return (Literal)-1;
+}
+
+void CdclProver::BumpAtom(int atom)
+{
+  activity[atom] += increment;
+  if (activity[atom] > 1e100)
+  {
+    for (int x = 0; x < activity.size(); x++)
+      activity[x] *= 1e-100;
+    increment *= 1e-100;
+  }
+
+  if (heapIndex[atom] >= 0)
+    HeapUp(heapIndex[atom]);
+}
+
+void CdclProver::BumpClause(int index)
+{
+  clauses[index].activity += clauseIncrement;
+  if (clauses[index].activity > 1e20f)
+  {
+    for (int x = 0; x < clauses.size(); x++)
+      clauses[x].activity *= 1e-20f;
+    clauseIncrement *= 1e-20f;
+  }
+}
+
+void CdclProver::ReduceLearned()
+{
+  vector<int> candidates;
+  for (int x = 0; x < clauses.size(); x++)
+  {
+    const Clause& c = clauses[x];
+    if (!c.learned || c.deleted || c.length <= 2)
+      continue;
+
+    // A clause that is the reason for an assignment must stay
+    Literal first = lits[c.offset];
+    if (Value(first) == 1 && reasons[AtomOf(first)] == x)
+      continue;
+
+    candidates.push_back(x);
+  }
+
+  sort(candidates.begin(), candidates.end(), [this](int a, int b) { return clauses[a].activity < clauses[b].activity; });
+
+  for (int x = 0; x < candidates.size() / 2; x++)
+  {
+    clauses[candidates[x]].deleted = true;
+    wasted += clauses[candidates[x]].length;
+    learnedCount--;
+  }
+  maxLearned *= 1.1;
+
+  // Compact the literal arena once most of it belongs to deleted clauses
+  if (wasted * 2 > lits.size())
+  {
+    vector<Literal> live;
+    live.reserve(lits.size() - wasted);
+    for (int x = 0; x < clauses.size(); x++)
+    {
+      Clause& c = clauses[x];
+      if (c.deleted)
+        continue;
+      uint32_t offset = (uint32_t)live.size();
+      live.insert(live.end(), lits.begin() + c.offset, lits.begin() + c.offset + c.length);
+      c.offset = offset;
+    }
+    lits.swap(live);
+    wasted = 0;
+  }
+}
+
+void CdclProver::HeapInsert(int atom)
+{
+  heapIndex[atom] = (int)heap.size();
+  heap.push_back(atom);
+  HeapUp(heapIndex[atom]);
+}
+
+void CdclProver::HeapUp(int position)
+{
+  int atom = heap[position];
+  while (position > 0)
+  {
+    int parent = (position - 1) / 2;
+    if (activity[heap[parent]] >= activity[atom])
+      break;
+    heap[position] = heap[parent];
+    heapIndex[heap[position]] = position;
+    position = parent;
+  }
+  heap[position] = atom;
+  heapIndex[atom] = position;
+}
+
+void CdclProver::HeapDown(int position)
+{
+  int atom = heap[position];
+  while (true)
+  {
+    int child = 2 * position + 1;
+    if (child >= heap.size())
+      break;
+    if (child + 1 < heap.size() && activity[heap[child + 1]] > activity[heap[child]])
+      child++;
+    if (activity[heap[child]] <= activity[atom])
+      break;
+    heap[position] = heap[child];
+    heapIndex[heap[position]] = position;
+    position = child;
+  }
+  heap[position] = atom;
+  heapIndex[atom] = position;
+}
+
+int CdclProver::HeapPop()
+{
+  int top = heap[0];
+  heapIndex[top] = -1;
+
+  int last = heap.back();
+  heap.pop_back();
+  if (!heap.empty())
+  {
+    heap[0] = last;
+    heapIndex[last] = 0;
+    HeapDown(0);
+  }
+  return top;
+}
+
+// The Luby restart sequence 1 1 2 1 1 2 4 1 1 2 1 1 2 4 8 ..., indexed from 0
+int CdclProver::Luby(int x)
+{
+  int size = 1;
+  int sequence = 0;
+  while (size < x + 1)
+  {
+    sequence++;
+    size = 2 * size + 1;
+  }
+
+  while (size - 1 != x)
+  {
+    size = (size - 1) / 2;
+    sequence--;
+    x = x % size;
+  }
+  return 1 << sequence;
+}
@@ -0,0 +1,106 @@
+// Cdcl.h : conflict-driven clause learning engine
+//
+
+#pragma once
+
+#include "Prover.h"
+
+// Decides the clause set with conflict-driven clause learning: two-watched-literal propagation, VSIDS branching
+// with phase saving, Luby restarts and activity-based deletion of learned clauses.
+//
+// The search keeps its own copy of every clause so it can reorder the literals for watching, but each clause it
+// learns is also derived in the database by ordinary resolution: conflict analysis resolves the conflict clause
+// with the reasons of its literals one step at a time, and a literal fixed at level 0 is resolved away against a
+// unit clause derived the same way. The final conflict is resolved down to False, so an unsatisfiable input
+// leaves a complete resolution proof behind for PrintVector.
+//
+// The input goes through a Preprocessor first, unless options.preprocess is off. A model found for the clauses
+// it leaves is extended to the ones it was given and kept in model.
+struct CdclProver : public Prover
+{
+public:
+  ProverOptions options;
+
+  CdclProver(const ProverOptions& opts);
+
+  int Prove(ClauseDatabase& db) override;
+
+private:
+  // A clause in the search. Its literals are lits[offset] .. lits[offset + length - 1], the first two watched.
+  struct Clause
+  {
+    uint32_t offset;
+    uint32_t length;
+    int id;
+    float activity;
+    bool learned;
+    bool deleted;
+  };
+
+  ClauseDatabase* db;
+  std::vector<Literal> lits;
+  std::vector<Clause> clauses;
+  std::vector<std::vector<int>> watches;
+  size_t wasted;
+
+  // Per literal: 1 true, -1 false, 0 unassigned. Per atom: decision level, reason clause and saved phase.
+  std::vector<signed char> values;
+  std::vector<int> levels;
+  std::vector<int> reasons;
+  std::vector<bool> phases;
+
+  std::vector<Literal> trail;
+  std::vector<size_t> trailLimits;
+  size_t head;
+
+  // Per atom, the id of a unit clause for its level 0 value, derived up to units[unitsDone - 1] of the trail
+  std::vector<int> units;
+  size_t unitsDone;
+
+  // VSIDS: atom activities and a binary max-heap of the atoms ordered by them
+  std::vector<double> activity;
+  double increment;
+  std::vector<int> heap;
+  std::vector<int> heapIndex;
+
+  float clauseIncrement;
+  int learnedCount;
+  double maxLearned;
+
+  std::vector<bool> marks;
+  std::vector<Literal> resolvent;
+  std::vector<Literal> scratch;
+
+  int Value(Literal l) const { return values[l]; }
+  int Level() const { return (int)trailLimits.size(); }
+
+  void Reset(ClauseDatabase& database);
+  int AddClause(int id, const Literal* begin, const Literal* end, bool learned);
+  void Assign(Literal l, int reason);
+
+  // Returns the index of a conflicting clause, or -1
+  int Propagate();
+
+  // Derives the learned clause of a conflict in the database and returns its id. Sets backjump to the level to
+  // return to.
+  int Analyze(int conflict, int& backjump);
+
+  // Resolves clause id against the unit clauses of every literal fixed at level 0 and returns the result
+  int StripLevelZero(int id);
+  void DeriveUnits();
+
+  int Resolve(int a, int b);
+  void Backtrack(int level);
+  Literal Decide();
+
+  void BumpAtom(int atom);
+  void BumpClause(int index);
+  void ReduceLearned();
+
+  void HeapInsert(int atom);
+  void HeapUp(int position);
+  void HeapDown(int position);
+  int HeapPop();
+
+  static int Luby(int x);
+};
@@ -0,0 +1,347 @@
+// ClauseDatabase.cpp : flat storage for every clause of a proof run
+//
+
+#include "stdafx.h"
+#include "ClauseDatabase.h"
+#include "Trace.h"
+
+using namespace std;
+
+int AtomTable::Intern(string_view name)
+{
+  key.assign(name.data(), name.size());
+  auto found = ids.find(key);
+  if (found != ids.end())
+    return found->second;
+
+  int id = (int)names.size();
+  names.push_back(key);
+  ids[key] = id;
+  return id;
+}
+
+Literal AtomTable::Parse(string_view token)
+{
+  if (token[0] == '~')
+    return MakeLiteral(Intern(token.substr(1)), true);
+  return MakeLiteral(Intern(token), false);
+}
+
+void ClauseDatabase::Normalize(vector<Literal>& lits)
+{
+  sort(lits.begin(), lits.end());
+  lits.erase(unique(lits.begin(), lits.end()), lits.end());
+}
+
+uint64_t ClauseDatabase::Signature(const Literal* begin, const Literal* end)
+{
+  uint64_t sig = 0;
+  for (const Literal* l = begin; l != end; l++)
+    sig |= 1ull << ((*l * 0x9e3779b1u) >> 26);
+  return sig;
+}
+
+bool ClauseDatabase::IsSubset(const Literal* aBegin, const Literal* aEnd, const Literal* bBegin, const Literal* bEnd)
+{
+  if (aEnd - aBegin > bEnd - bBegin)
+    return false;
+
+  while (aBegin != aEnd)
+  {
+    // Skip the literals of b that are smaller than the next literal of a; if a's literal is not next, it is missing
+    while (bBegin != bEnd && *bBegin < *aBegin)
+      bBegin++;
+    if (bBegin == bEnd || *bBegin != *aBegin)
+      return false;
+
+    aBegin++;
+    bBegin++;
+  }
+  return true;
+}
+
+int ClauseDatabase::Add(const vector<Literal>& lits, int parent1, int parent2)
+{
+  ClauseHeader h;
+  h.offset = (uint32_t)pool.size();
+  h.length = (uint32_t)lits.size();
+  h.id = Size();
+  h.parents[0] = parent1;
+  h.parents[1] = parent2;
+  h.level = parent1 < 0 ? scope : max(Level(parent1), Level(parent2));
+
+  pool.insert(pool.end(), lits.begin(), lits.end());
+  headers.push_back(h);
+  signatures.push_back(Signature(lits.data(), lits.data() + lits.size()));
+
+  if (trace != NULL)
+    trace->Added(*this, h.id);
+  return h.id;
+}
+
+void ClauseDatabase::Push()
+{
+  scope++;
+  scopeStarts.push_back(Size());
+}
+
+int ClauseDatabase::Pop()
+{
+  int first = scopeStarts.back();
+  scopeStarts.pop_back();
+  scope--;
+
+  // Every clause above the new level was added after the push, since no clause is ever above the scope it was
+  // added in
+  for (int x = first; x < Size(); x++)
+  {
+    if (headers[x].level > scope)
+    {
+      headers[x].level = DeadLevel;
+      if (trace != NULL)
+        trace->Deleted(x);
+    }
+  }
+  return first;
+}
+
+bool ClauseDatabase::Resolve(int a, int b, vector<Literal>& resolvent) const
+{
+  const Literal* x = Begin(a);
+  const Literal* xEnd = End(a);
+  const Literal* y = Begin(b);
+  const Literal* yEnd = End(b);
+
+  resolvent.clear();
+
+  // Equal literals are kept once and a complementary pair (I.E x31 and ~x31) is dropped
+  int clashes = 0;
+  while (x != xEnd && y != yEnd)
+  {
+    Literal l = *x;
+    Literal r = *y;
+
+    if (l == r)
+    {
+      resolvent.push_back(l);
+      x++;
+      y++;
+    }
+    else if (l == Complement(r))
+    {
+      if (++clashes > 1)
+        return false;
+      x++;
+      y++;
+    }
+    else if (l < r)
+    {
+      resolvent.push_back(l);
+      x++;
+    }
+    else
+    {
+      resolvent.push_back(r);
+      y++;
+    }
+  }
+
+  if (clashes == 0)
+    return false;
+
+  resolvent.insert(resolvent.end(), x, xEnd);
+  resolvent.insert(resolvent.end(), y, yEnd);
+  return true;
+}
+
+bool ClauseDatabase::ContainsNegatedLiteral(int id, Literal lit) const
+{
+  return binary_search(Begin(id), End(id), Complement(lit));
+}
+
+vector<int> ClauseDatabase::ExtractProof(int id) const
+{
+  vector<int> proof;
+  vector<bool> visited(headers.size(), false);
+  vector<int> stack = { id };
+  visited[id] = true;
+
+  while (!stack.empty())
+  {
+    int current = stack.back();
+    stack.pop_back();
+    proof.push_back(current);
+
+    for (int x = 0; x < 2; x++)
+    {
+      int parent = headers[current].parents[x];
+      if (parent >= 0 && !visited[parent])
+      {
+        visited[parent] = true;
+        stack.push_back(parent);
+      }
+    }
+  }
+
+  sort(proof.begin(), proof.end());
+  return proof;
+}
+
+string ClauseDatabase::Name(int id) const
+{
+  if (Length(id) == 0)
+    return "False";
+
+  string name = "";
+  for (const Literal* l = Begin(id); l != End(id); l++)
+  {
+    if (IsNegated(*l))
+      name += '~';
+    name += atoms.names[AtomOf(*l)] + " ";
+  }
+  return name;
+}
+
+void ClauseDatabase::Print(ostream& os, int id) const
+{
+  const ClauseHeader& h = headers[id];
+  os << h.id << ". ";
+
+  // The same text as Name, written straight to the stream
+  if (Length(id) == 0)
+    os << "False";
+  for (const Literal* l = Begin(id); l != End(id); l++)
+  {
+    if (IsNegated(*l))
+      os << '~';
+    os << atoms.names[AtomOf(*l)] << ' ';
+  }
+  os << " {";
+
+  if (h.parents[0] >= 0)
+    os << h.parents[0] << ", " << h.parents[1];
+
+  os << "}";
+}
+
+void ClauseDatabase::Release()
+{
+  vector<Literal>().swap(pool);
+  vector<ClauseHeader>().swap(headers);
+  vector<uint64_t>().swap(signatures);
+  atoms = AtomTable();
+  scope = 0;
+  scopeStarts.clear();
+}
+
+ClauseSet::ClauseSet()
+{
+  Slot empty = { 0, -1 };
+  slots.assign(64, empty);
+  count = 0;
+}
+
+uint64_t ClauseSet::Hash(const Literal* begin, const Literal* end)
+{
+  uint64_t h = 0xcbf29ce484222325ull;
+  for (const Literal* l = begin; l != end; l++)
+    h = (h ^ *l) * 0x100000001b3ull;
+
+  // Final avalanche so that the low bits used for the slot index depend on every literal
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdull;
+  h ^= h >> 33;
+  return h;
+}
+
+int ClauseSet::Find(const ClauseDatabase& db, const Literal* begin, const Literal* end) const
+{
+  uint64_t h = Hash(begin, end);
+  size_t mask = slots.size() - 1;
+
+  for (size_t x = h & mask; slots[x].id >= 0; x = (x + 1) & mask)
+  {
+    const Slot& s = slots[x];
+    if (s.hash == h && db.Length(s.id) == end - begin && equal(begin, end, db.Begin(s.id)))
+      return s.id;
+  }
+  return -1;
+}
+
+void ClauseSet::Insert(const ClauseDatabase& db, int id)
+{
+  // Keep the table at most half full so probe sequences stay short
+  if ((count + 1) * 2 > slots.size())
+    Grow();
+
+  uint64_t h = Hash(db.Begin(id), db.End(id));
+  size_t mask = slots.size() - 1;
+
+  size_t x = h & mask;
+  while (slots[x].id >= 0)
+    x = (x + 1) & mask;
+
+  slots[x].hash = h;
+  slots[x].id = id;
+  count++;
+}
+
+void ClauseSet::Erase(const ClauseDatabase& db, int id)
+{
+  size_t mask = slots.size() - 1;
+  size_t x = Hash(db.Begin(id), db.End(id)) & mask;
+  while (slots[x].id >= 0 && slots[x].id != id)
+    x = (x + 1) & mask;
+
+  if (slots[x].id < 0)
+    return;
+
+  // Shift later entries of the probe run back into the hole, so every remaining entry can still be reached
+  // from its home slot without tombstones
+  size_t hole = x;
+  for (size_t y = (x + 1) & mask; slots[y].id >= 0; y = (y + 1) & mask)
+  {
+    size_t home = slots[y].hash & mask;
+    if (((y - home) & mask) >= ((y - hole) & mask))
+    {
+      slots[hole] = slots[y];
+      hole = y;
+    }
+  }
+
+  slots[hole].id = -1;
+  count--;
+}
+
+void ClauseSet::Grow()
+{
+  Slot empty = { 0, -1 };
+  vector<Slot> old(slots.size() * 2, empty);
+  old.swap(slots);
+
+  size_t mask = slots.size() - 1;
+  for (size_t y = 0; y < old.size(); y++)
+  {
+    if (old[y].id < 0)
+      continue;
+
+    size_t x = old[y].hash & mask;
+    while (slots[x].id >= 0)
+      x = (x + 1) & mask;
+    slots[x] = old[y];
+  }
+}
+
+void OccurrenceIndex::Insert(const ClauseDatabase& db, int id)
+{
+  for (const Literal* l = db.Begin(id); l != db.End(id); l++)
+    Add(*l, id);
+}
+
+void OccurrenceIndex::Add(Literal l, int id)
+{
+  // Size the table for both signs of the atom at once
+  if (l >= lists.size())
+    lists.resize((l | 1u) + 1);
+  lists[l].push_back(id);
+}
@@ -0,0 +1,174 @@
+// ClauseDatabase.h : flat storage for every clause of a proof run
+//
+
+#pragma once
+
+// A literal is an interned atom id shifted left by one, with the low bit set when the atom is negated.
+// Sorting literals by value keeps every atom right next to its complement.
+typedef uint32_t Literal;
+
+inline Literal MakeLiteral(int atom, bool negated) { return (Literal(atom) << 1) | (negated ? 1u : 0u); }
+inline int AtomOf(Literal l) { return int(l >> 1); }
+inline bool IsNegated(Literal l) { return (l & 1u) != 0; }
+inline Literal Complement(Literal l) { return l ^ 1u; }
+
+// Maps every atom name seen while reading the input to a dense id, and back again for printing
+struct AtomTable
+{
+public:
+  std::vector<std::string> names;
+  std::unordered_map<std::string, int> ids;
+
+  int Intern(std::string_view name);
+
+  // Turns a token such as "~x31" into its literal, interning the atom if needed
+  Literal Parse(std::string_view token);
+
+private:
+  // Reused lookup key, so finding an atom that is already interned allocates nothing
+  std::string key;
+};
+
+struct ClauseTrace;
+
+// Fixed-size description of one clause. Its literals are pool[offset] .. pool[offset + length - 1].
+// The parent ids are the edges of the proof DAG; input clauses have no parents, so both are -1.
+// The level is the innermost scope the clause depends on (see ClauseDatabase::Push), or DeadLevel once that
+// scope has been popped.
+struct ClauseHeader
+{
+  uint32_t offset;
+  uint32_t length;
+  int id;
+  int parents[2];
+  int level;
+};
+
+// Owns every clause of a proof run. The literals of all clauses are appended to one contiguous pool that acts
+// as an arena: nothing is allocated per clause, and Release frees the whole run in one step.
+//
+// Clauses can be added inside nested scopes. An input clause belongs to the scope open when it was added and a
+// resolvent to the innermost scope of its parents, so a clause derived from permanent clauses alone stays at
+// level 0 whenever it was derived. Pop kills every clause of the closed scope; dead clauses keep their ids and
+// literals, since the arena only shrinks when Saturation::Collect compacts it, but take no further part.
+struct ClauseDatabase
+{
+public:
+  static const int DeadLevel = 0x7fffffff;
+
+  AtomTable atoms;
+  std::vector<Literal> pool;
+  std::vector<ClauseHeader> headers;
+  std::vector<uint64_t> signatures;
+
+  // The current scope depth, and for each open scope the database size when it was pushed
+  int scope = 0;
+  std::vector<int> scopeStarts;
+
+  // Records every clause added and every clause killed, if set. A copy of the database shares it.
+  ClauseTrace* trace = NULL;
+
+  int Size() const { return (int)headers.size(); }
+  int Length(int id) const { return (int)headers[id].length; }
+  int Level(int id) const { return headers[id].level; }
+  bool IsDead(int id) const { return headers[id].level == DeadLevel; }
+  const Literal* Begin(int id) const { return pool.data() + headers[id].offset; }
+  const Literal* End(int id) const { return Begin(id) + headers[id].length; }
+
+  // Sorts the literals and removes duplicates, which is the standard form every stored clause is kept in
+  static void Normalize(std::vector<Literal>& lits);
+
+  // 64-bit summary of a literal set with one bit per literal hash. If a is a subset of b then every bit of
+  // Signature(a) is also set in Signature(b), so most non-subsets are ruled out with one AND.
+  static uint64_t Signature(const Literal* begin, const Literal* end);
+
+  // Finds if the sorted literals of a are a subset of the sorted literals of b
+  static bool IsSubset(const Literal* aBegin, const Literal* aEnd, const Literal* bBegin, const Literal* bEnd);
+
+  // Appends a clause whose literals are already in standard form and returns its id
+  int Add(const std::vector<Literal>& lits, int parent1 = -1, int parent2 = -1);
+
+  // Opens a new scope
+  void Push();
+
+  // Closes the innermost scope and kills every clause at a level above the new one. Returns the id of the
+  // first clause added since the matching Push, since no clause before it can have died.
+  int Pop();
+
+  // Applies the resolution principle to clauses a and b with one merge of their sorted literal arrays.
+  // Returns false unless they clash on exactly one atom, since resolving a pair that clashes on two or more
+  // atoms can only ever give a tautology.
+  bool Resolve(int a, int b, std::vector<Literal>& resolvent) const;
+
+  // Finds if clause id contains the complement of lit
+  bool ContainsNegatedLiteral(int id, Literal lit) const;
+
+  // Walks the parent ids backwards from clause id and returns every clause of its derivation exactly once,
+  // ordered by id. Each clause is visited once, so this is linear in the size of the proof.
+  std::vector<int> ExtractProof(int id) const;
+
+  // The clause's literals separated by spaces, or "False" for the empty clause
+  std::string Name(int id) const;
+
+  // Prints the clause as "ID. literals {parent, parent}"
+  void Print(std::ostream& os, int id) const;
+
+  // Bytes the database has allocated for its clauses
+  size_t Bytes() const { return pool.capacity() * sizeof(Literal) + headers.capacity() * sizeof(ClauseHeader) + signatures.capacity() * sizeof(uint64_t); }
+
+  // Frees the pool and the headers in one step
+  void Release();
+};
+
+// Open-addressing hash set of clause ids, keyed on each clause's sorted literal array. Because every stored
+// clause is in standard form, equal clauses always hash the same and a duplicate is found in constant time.
+struct ClauseSet
+{
+public:
+  ClauseSet();
+
+  // Canonical hash of a sorted literal array
+  static uint64_t Hash(const Literal* begin, const Literal* end);
+
+  // Returns the id of a stored clause with exactly these literals, or -1 if there is none
+  int Find(const ClauseDatabase& db, const Literal* begin, const Literal* end) const;
+  int Find(const ClauseDatabase& db, const std::vector<Literal>& lits) const { return Find(db, lits.data(), lits.data() + lits.size()); }
+
+  // Adds clause id, which must not already be in the set
+  void Insert(const ClauseDatabase& db, int id);
+
+  // Removes clause id if it is in the set
+  void Erase(const ClauseDatabase& db, int id);
+
+  int Size() const { return count; }
+
+private:
+  struct Slot
+  {
+    uint64_t hash;
+    int id;
+  };
+
+  std::vector<Slot> slots;
+  int count;
+
+  void Grow();
+};
+
+// Inverted index from each literal to the ids of the indexed clauses that contain it, in insertion order.
+// The clauses a clause can resolve with on literal l are exactly the ones listed under Complement(l).
+struct OccurrenceIndex
+{
+public:
+  std::vector<std::vector<int>> lists;
+
+  void Insert(const ClauseDatabase& db, int id);
+
+  // Lists id under l only
+  void Add(Literal l, int id);
+
+  const std::vector<int>& Occurrences(Literal l) const { return l < lists.size() ? lists[l] : none; }
+
+private:
+  std::vector<int> none;
+};
@@ -201,307 +201,125 @@ argument(and no other arguments, please!). Also hand in a copy of the files ment
 */
 
 #include "stdafx.h"
+#include "ClauseDatabase.h"
+#include "Saturation.h"
+#include "Prover.h"
+#include "ClauseReader.h"
+#include "Dimacs.h"
+#include "KnowledgeBase.h"
+#include "CommandLine.h"
+#include "Formula.h"
+#include "Trace.h"
 
 using namespace std;
 
-struct Literal;
-struct Clause;
+// How the text of an input file is written: one clause per line, DIMACS CNF, or one formula per line
+enum InputFormat { ClauseInput, DimacsInput, FormulaInput };
 
-vector<Clause*> originalClauses;
-int clauseNum = 0;
-
-struct Literal 
+// The format a file name's extension suggests: ".cnf" for DIMACS, ".fml" for formulas, otherwise clauses
+InputFormat FormatOf(const string& fileName)
 {
-public:
-
-  string name;
-  bool negated = false;
-
-  Literal(string n) 
-  {
-    if (negated = ( n[0] == '~') ) 
-      name = n.substr(1, n.size()-1);
-    else 
-      name = n;
-  }
-};
+  auto endsWith = [&](const char* suffix) { return fileName.size() >= 4 && fileName.compare(fileName.size() - 4, 4, suffix) == 0; };
+  if (endsWith(".cnf"))
+    return DimacsInput;
+  if (endsWith(".fml"))
+    return FormulaInput;
+  return ClauseInput;
+}
 
-struct Clause 
+// Reads the clauses of fileName into db: from a compiled image if the file is one, otherwise as format says. For
+// a formula file, lastFormula is set to the number of clauses of its last formula, the negated query. Returns false
+// if the file cannot be opened or is an image that cannot be loaded.
+bool InitializeClauses(string fileName, ClauseDatabase& db, InputFormat format = ClauseInput, int* lastFormula = NULL) 
 {
-public:
-  vector<Literal*> literals;
-  string name;
-  int ID;
-  vector<Clause> parents;
-
-  Clause(vector<Literal*> lits) 
-  {
-    ID = clauseNum;
-    clauseNum++;
-
-    literals = lits;
-    
-    SortLiterals();
-
-    literals.erase(unique(literals.begin(), literals.end()), literals.end());
-
-    CreateName();
-  }
-
-  Clause(vector<Literal*> lits, vector<Clause> p)
-  {
-    ID = clauseNum;
-    clauseNum++;
-    literals = lits;
-    parents = p;
-
-    SortLiterals();
-    literals.erase(unique(literals.begin(), literals.end()), literals.end());
-    CreateName();
-  }
-
-  // Negates the clause and adds each literal as a separate clause
-  vector<Clause*> Negate()
-  {
-    vector<Clause*> negations;
-    vector<Literal*> newLits = literals;
-
-    for (int x = 0; x < newLits.size(); x++)
-    {
-      Literal* l = literals[x];
-      l->negated = !l->negated;
-      vector<Literal*> lits = { l };
-      negations.push_back(new Clause(lits));
-    }
-    return negations;
-  }
-
-  // + Operator overloader. Essentially applies the resolution principle to the two clauses, and adds the result to the clauseVector
-  Clause* operator+(const Clause& b) 
+  MappedFile file(fileName);
+  if (!file.IsOpen())
   {
-    vector<Literal*> newL;
-
-    // Combine the Clause's literal lists
-    newL.reserve(literals.size() + b.literals.size());
-    newL.insert(newL.end(), literals.begin(), literals.end());
-    newL.insert(newL.end(), b.literals.begin(), b.literals.end());
-
-    // Go through the list. Remove duplicates of the literal.
-    // If there is a negated version of the same literal (I.E x31 and ~x31), remove both literals and go to the next literal
-    int index = 0;
-    while(index < newL.size())
-    {
-      Literal* l = newL[index];
-
-      for (int x = index+1; x < newL.size(); x++) 
-      {
-        // Are they the same literal?
-        if (l->name == newL[x]->name) 
-        {
-          // If it's an opposite literal, delete both, move to the next Literal
-          if (l->negated != newL[x]->negated) 
-          {
-            newL.erase(newL.begin() + x);
-            newL.erase(newL.begin() + index);
-            index--;
-            break;
-          }
-          // Otherwise it's a duplicate. Delete the duplicate and move on
-          else 
-          {
-            newL.erase(newL.begin() + x);
-            x--;
-          }
-        }
-      }
-      index++;
-    }
-    vector<Clause> parents = { *this, b };
-
-    Clause* c = new Clause(newL, parents);
-    
-    if(newL.size() == 0)
-      c->name = "False";
-
-    return c;
+    cerr << fileName << ": cannot open file" << endl;
+    return false;
   }
 
-  // << Operator overloader. Prints out the clause
-  friend ostream& operator<<(ostream& os, const Clause& c) 
-  {
-    os << c.ID << ". " << c.name << " {";
+  if (IsImage(file.Begin(), file.End()))
+    return LoadImage(file.Begin(), file.End(), fileName, db, cerr);
 
-    if (c.parents.size() > 0)
-    {
-      for (int x = 0; x < c.parents.size() - 1; x++)
-        os << c.parents[x].ID << ", ";
-
-      os << c.parents[c.parents.size() - 1].ID;
-    }
-
-    os << "}";
+  // The text is scanned in place; malformed lines are reported on cerr and skipped
+  int last = 0;
+  if (format == DimacsInput)
+    ReadDimacs(file.Begin(), file.End(), fileName, db, cerr);
+  else if (format == FormulaInput)
+    ReadFormulas(file.Begin(), file.End(), fileName, db, cerr, last);
+  else
+    ReadClauses(file.Begin(), file.End(), fileName, db, cerr);
 
-    return os;
-  }
+  if (lastFormula != NULL)
+    *lastFormula = last;
+  return true;
+}
 
-  // Finds if this clause contains a given literal in its negated form
-  bool ContainsNegatedLiteral(Literal* lit)
-  {
-    for (int x = 0; x < literals.size(); x++)
-    {
-      Literal* l = literals[x];
-      if (l->name == lit->name && l->negated != lit->negated)
-        return true;
-    }
+// Reads fileName and writes it back out as a compiled image, which later runs load without parsing
+bool Compile(string fileName, InputFormat format, string imageFile)
+{
+  ClauseDatabase db;
+  if (!InitializeClauses(fileName, db, format))
     return false;
-  }
-
-  void CreateName() 
-  {
-    name = "";
-
-    for (int x = 0; x < literals.size(); x++)
-    {
-      if (literals[x]->negated)
-        name += '~';
-      name += literals[x]->name + " ";
-    }
-  }
 
-  void SortLiterals()
+  if (!WriteImage(imageFile, db))
   {
-    for (int x = 0; x<literals.size(); x++)
-    {
-      int minI = x;
-
-      for (int y = x; y<literals.size(); y++)
-        if (literals[minI]->name > literals[y]->name)
-          minI = y;
-
-      Literal* temp = literals[x];
-      literals[x] = literals[minI];
-      literals[minI] = temp;
-    }
+    cerr << imageFile << ": cannot write image" << endl;
+    return false;
   }
-};
 
-bool ContainsClause(Clause* c, vector<Clause*> v) 
-{
-  for (int x = 0; x < v.size(); x++) 
-  {
-    if (v[x]->name == c->name)
-      return true;
-  }
-  return false;
+  cout << "Compiled " << db.Size() << " clauses over " << db.atoms.names.size() << " atoms into " << imageFile << endl;
+  return true;
 }
 
-void InitializeClauses(string fileName) 
+// Prints the derivation of the False clause. Lines end in '\n' rather than endl, so a long proof goes out in
+// large buffered writes and the stream is flushed once, by its owner, at the end.
+void PrintVector(const ClauseDatabase& db, int falseClause, ostream& output) 
 {
-  ifstream iFile;
-  iFile.open(fileName);
+  vector<int> clauses = db.ExtractProof(falseClause);
 
-  // Go line by line, split the string via white spaces, create new literals if needed. 
-  // Make a new clause for each line.
-  string line = "";
-  while (getline(iFile, line))
+  for (int x = 0; x < clauses.size(); x++) 
   {
-    //cout << "Line: " << line << endl;
-    istringstream buf(line);
-    istream_iterator<string> beg(buf), end;
-    vector<string> tokens(beg, end); // done!
-
-    vector<Literal*> lits;
-
-    // Go through and add the literals as needed
-    for (int x = 0; x < tokens.size(); x++)
-      lits.push_back(new Literal(tokens[x]));
-
-    Clause* c = new Clause(lits);
-
-    originalClauses.push_back(c);
+    db.Print(output, clauses[x]);
+    output << '\n';
   }
-}
 
-Clause* ApplyResolution(Clause* cMain, Clause* cOther) 
-{
-  Clause* c = *cMain + *cOther;
-  return c;
+  output << "Final Clause Size: " << db.Size() << '\n';
 }
 
-void SortClausesBySize() 
+// Prints the verdict on the query, followed by the proof of False, or by the countermodel if the engine found one
+// and every clause of the saturated set. Without a query, an empty name, the verdict is on the input as a whole.
+void PrintResult(const ClauseDatabase& db, const string& query, int falseClause, const vector<signed char>& model,
+  ostream& output)
 {
-  for (int x = 0; x<originalClauses.size(); x++)
+  if (falseClause >= 0)
   {
-    int minI = x;
-
-    for (int y = x; y<originalClauses.size(); y++)
-      if (originalClauses[minI]->literals.size() > originalClauses[y]->literals.size())
-        minI = y;
-
-    Clause* temp = originalClauses[x];
-    originalClauses[x] = originalClauses[minI];
-    originalClauses[minI] = temp;
+    output << "Found contradiction, " << (query.empty() ? "the input is unsatisfiable" : query + " is valid") << '\n';
+    PrintVector(db, falseClause, output);
+    return;
   }
-}
 
-vector<Clause> SortClausesByID(vector<Clause> v)
-{
-  for (int x = 0; x<v.size(); x++)
+  if (falseClause == UnknownResult)
   {
-    int minI = x;
-
-    for (int y = x; y<v.size(); y++)
-      if (v[minI].ID > v[y].ID)
-        minI = y;
-
-    Clause temp = v[x];
-    v[x] = v[minI];
-    v[minI] = temp;
+    output << "Ran out of budget, unknown whether " << (query.empty() ? "the input is satisfiable" : query + " is valid") << '\n';
+    output << "Final Clause Size: " << db.Size() << '\n';
+    return;
   }
 
-  return v;
-}
-
-void PrintVector(vector<Clause*> v, string fileName) 
-{
-  Clause* currentClause = v[v.size() - 1];
-  vector<Clause> clauses = 
+  output << "Did not find contradiction, " << (query.empty() ? "the input is satisfiable" : query + " is not valid") << '\n';
+  if (!model.empty())
   {
-    *currentClause, 
-    currentClause->parents[0], 
-    currentClause->parents[1] 
-  };
-
-  bool noParents = false;
-  int index = 1;
-  while (index < clauses.size()) 
-  {
-    Clause c = clauses[index];
-
-    if (c.parents.size() > 0) 
-    {
-      clauses.push_back(c.parents[0]);
-      clauses.push_back(c.parents[1]);
-    }
-
-    index++;
+    output << "Countermodel:";
+    for (int x = 0; x < model.size(); x++)
+      output << ' ' << (model[x] < 0 ? "~" : "") << db.atoms.names[x];
+    output << '\n';
   }
-
-  clauses = SortClausesByID(clauses);
-
-  ofstream output;
-  output.open(fileName + ".out.txt");
-
-  for (int x = 0; x < clauses.size(); x++) 
+  for (int x = 0; x < db.Size(); x++)
   {
-    output << clauses[x] << endl;
-    cout << clauses[x] << endl;
+    db.Print(output, x);
+    output << '\n';
   }
-
-  output << "Final Clause Size: " << v.size() << endl;
-  cout << "Final Clause Size: " << v.size() << endl;
-  
-  output.close();
 }
 
 /*
@@ -596,69 +414,401 @@ void PartA(string fileName)
 }
 */
 
-void PartB(string file)
+// Writes the run's statistics as JSON to statsFile, or to cout if it is "-". Does nothing if it is empty.
+void WriteStats(const ProverStats& stats, const string& statsFile)
+{
+  if (statsFile.empty())
+    return;
+
+  if (statsFile == "-")
+  {
+    stats.WriteJson(cout);
+    return;
+  }
+
+  ofstream output(statsFile);
+  if (!output)
+  {
+    cerr << statsFile << ": cannot create file" << endl;
+    return;
+  }
+  stats.WriteJson(output);
+}
+
+// Prints the proof recorded in a trace written with --trace, or every clause in it if the run did not derive
+// False. Returns false if the trace cannot be read in full.
+bool RenderTrace(string traceFile)
+{
+  MappedFile file(traceFile);
+  if (!file.IsOpen())
+  {
+    cerr << traceFile << ": cannot open file" << endl;
+    return false;
+  }
+
+  ClauseDatabase db;
+  bool complete = ReadTrace(file.Begin(), file.End(), traceFile, db, cerr);
+
+  for (int x = 0; x < db.Size(); x++)
+  {
+    if (db.Length(x) == 0)
+    {
+      cout << "Found contradiction\n";
+      PrintVector(db, x, cout);
+      return complete;
+    }
+  }
+
+  cout << "Did not find contradiction\n";
+  for (int x = 0; x < db.Size(); x++)
+  {
+    db.Print(cout, x);
+    cout << '\n';
+  }
+  cout << "Final Clause Size: " << db.Size() << '\n';
+  return complete;
+}
+
+// The file name without its last extension, used to name the output files
+string Stem(const string& fileName)
+{
+  size_t dot = fileName.find_last_of('.');
+  size_t slash = fileName.find_last_of("/\\");
+  if (dot == string::npos || (slash != string::npos && dot < slash))
+    return fileName;
+  return fileName.substr(0, dot);
+}
+
+// Where the proof for fileName goes: "task4.in.txt" gives "task4.out.txt", and any other name has its last
+// extension replaced, so "php7.cnf" gives "php7.out.txt"
+string OutputName(const string& fileName)
+{
+  const string input = ".in.txt";
+  if (fileName.size() > input.size() && fileName.compare(fileName.size() - input.size(), input.size(), input) == 0)
+    return fileName.substr(0, fileName.size() - input.size()) + ".out.txt";
+  return Stem(fileName) + ".out.txt";
+}
+
+// Proves the query at the end of file. For a formula file the clauses of the last formula are the set of support,
+// unless queryGiven says --query chose how many there are.
+void PartB(string file, const ProverOptions& options, InputFormat format, bool queryGiven, string exportFile, string statsFile,
+  string traceFile)
 {
   string fileName = file;
-  InitializeClauses(fileName);
+  ProverOptions runOptions = options;
+  ProverStats stats;
 
-  vector<Clause*> clauses = originalClauses;
+  // Every clause of the run, the input clauses first and then the resolvents in the order they are derived
+  ClauseDatabase clauseDb;
+  {
+    PhaseTimer timer(stats, "parse");
+    int lastFormula;
+    if (!InitializeClauses(fileName, clauseDb, format, &lastFormula))
+      return;
+    if (format == FormulaInput && !queryGiven)
+      runOptions.queryClauses = lastFormula;
+  }
 
-  Clause* clauseToProve = clauses[clauses.size()-1];
+  // The query is the last clause. An empty input has none, and neither does a formula file whose last formula
+  // gives no clauses: it is true in every model, so the other clauses are decided on their own, without a set of
+  // support.
+  string query = "";
+  if (clauseDb.Size() > 0 && (format != FormulaInput || queryGiven || runOptions.queryClauses > 0))
+    query = clauseDb.Name(clauseDb.Size() - 1);
 
-  bool foundContradiction = false;
-  int index = 0;
-  while (index < clauses.size())
+  if (!exportFile.empty())
   {
-    Clause* current = clauses[index];
-    int i = index + 1;
+    vector<int> inputs(clauseDb.Size());
+    for (int x = 0; x < inputs.size(); x++)
+      inputs[x] = x;
+
+    if (!WriteDimacsFile(exportFile, clauseDb, inputs))
+      cerr << exportFile << ": cannot create file" << endl;
+  }
 
-    while (i < clauses.size())
+  // The trace takes the input as it was read, then every clause the search adds as it adds it
+  ClauseTrace trace;
+  if (!traceFile.empty())
+  {
+    if (trace.Open(traceFile))
     {
-      Clause* compare = clauses[i];
+      trace.AddExisting(clauseDb);
+      clauseDb.trace = &trace;
+    }
+    else
+      cerr << traceFile << ": cannot create file" << endl;
+  }
 
-      for (int x = 0; x < current->literals.size(); x++)
+  unique_ptr<Prover> prover = MakeProver(runOptions);
+  int falseClause;
+  {
+    PhaseTimer timer(stats, "search");
+    falseClause = prover->Prove(clauseDb);
+  }
+  clauseDb.trace = NULL;
+  trace.Close();
+  stats.Add(prover->stats);
+  stats.Sample(clauseDb);
+
+  {
+    PhaseTimer timer(stats, "output");
+
+    // A DIMACS instance has no query clause, so only the SAT competition style verdict is printed for it
+    if (format == DimacsInput)
+    {
+      cout << (falseClause >= 0 ? "s UNSATISFIABLE" : falseClause == UnknownResult ? "s UNKNOWN" : "s SATISFIABLE") << '\n';
+      if (!prover->model.empty())
       {
-        Literal* l = current->literals[x];
-        if (compare->ContainsNegatedLiteral(l))
-        {
-          Clause* result = ApplyResolution(current, compare);
-          clauses.push_back(result);
-          break;
-        }
+        cout << 'v';
+        for (int x = 0; x < prover->model.size(); x++)
+          cout << ' ' << (prover->model[x] < 0 ? "-" : "") << clauseDb.atoms.names[x];
+        cout << " 0\n";
       }
+      cout << "Final Clause Size: " << clauseDb.Size() << '\n';
+    }
+    else
+      PrintResult(clauseDb, query, falseClause, prover->model, cout);
 
-      if (foundContradiction = (clauses.back()->literals.size() == 0))
-        break;
-
-      i++;
+    // The proof alone also goes to a file
+    if (falseClause >= 0)
+    {
+      ofstream output;
+      output.open(OutputName(fileName));
+      PrintVector(clauseDb, falseClause, output);
+      output.close();
     }
+  }
 
-    if (foundContradiction)
-      break;
+  WriteStats(stats, statsFile);
+  clauseDb.Release();
+}
 
-    index++;
+// Answers every query in queryFile against the knowledge base in kbFile. The knowledge base is parsed once into a
+// base database that is never written to again; each query is then run on a worker thread against its own copy of
+// the base, with the query line appended as the last clause just like in a single-file run. Query n (counting from
+// 1, blank lines skipped) writes its verdict and proof to "<queryFile stem>.n.out.txt", and the verdicts are
+// printed in query order once every query is done.
+void PartC(string kbFile, string queryFile, const ProverOptions& options, InputFormat format, string statsFile)
+{
+  ClauseDatabase base;
+  ProverStats stats;
+  {
+    PhaseTimer timer(stats, "parse");
+    if (!InitializeClauses(kbFile, base, format))
+      return;
   }
 
-  if (foundContradiction)
+  // Keep the query lines as they are, since each worker interns their atoms into its own copy of the atom table
+  MappedFile qFile(queryFile);
+  if (!qFile.IsOpen())
   {
-    cout << "Found contradiction, " << clauseToProve->name << " is valid" << endl;
-    string outFile = fileName.substr(0, 5);
-    PrintVector(clauses, outFile);
+    cerr << queryFile << ": cannot open file" << endl;
+    return;
   }
 
-  else 
+  vector<string_view> queries;
+  for (const char* line = qFile.Begin(); line != qFile.End(); )
   {
-    cout << "Did not find contradiction, " << clauseToProve->name << " is not valid" << endl;
-    for (int x = 0; x < clauses.size(); x++)
-      cout << *clauses[x] << endl;
+    const char* lineEnd = find(line, qFile.End(), '\n');
+    if (find_if(line, lineEnd, [](char c) { return c != ' ' && c != '\t' && c != '\r'; }) != lineEnd)
+      queries.push_back(string_view(line, lineEnd - line));
+    line = lineEnd == qFile.End() ? lineEnd : lineEnd + 1;
   }
+
+  // The threads work on separate queries, so each query saturates sequentially
+  ProverOptions queryOptions = options;
+  queryOptions.threads = 1;
+
+  int workers = options.threads > 1 ? options.threads : (int)thread::hardware_concurrency();
+  workers = max(1, min(workers, (int)queries.size()));
+
+  vector<string> verdicts(queries.size());
+  vector<ProverStats> queryStats(queries.size());
+  atomic<int> next(0);
+
+  WorkerPool pool(workers, [&](int)
+  {
+    vector<Literal> lits;
+    int q;
+    while ((q = next++) < queries.size())
+    {
+      // Copying the base is a few flat array copies, far cheaper than parsing and interning the file again
+      ClauseDatabase db = base;
+      ProverOptions runOptions = queryOptions;
+      const char* begin = queries[q].data();
+      const char* end = begin + queries[q].size();
+
+      // With a formula knowledge base the query lines are formulas too, and all of a query's clauses are the
+      // set of support
+      const char* problem;
+      if (format == FormulaInput)
+        problem = CnfConverter(db).Add(begin, end, runOptions.queryClauses);
+      else if ((problem = ParseClause(begin, end, db.atoms, lits)) == NULL)
+        db.Add(lits);
+
+      if (problem != NULL)
+      {
+        verdicts[q] = string("malformed query: ") + problem;
+        continue;
+      }
+      // A formula query that gives no clauses is named by its line, and decides the knowledge base on its own
+      string query = format == FormulaInput && runOptions.queryClauses == 0 ? string(queries[q]) : db.Name(db.Size() - 1);
+
+      unique_ptr<Prover> prover = MakeProver(runOptions);
+      int falseClause;
+      {
+        PhaseTimer timer(queryStats[q], "search");
+        falseClause = prover->Prove(db);
+      }
+      queryStats[q].Add(prover->stats);
+      queryStats[q].Sample(db);
+
+      {
+        PhaseTimer timer(queryStats[q], "output");
+        ofstream output;
+        output.open(Stem(queryFile) + "." + to_string(q + 1) + ".out.txt");
+        PrintResult(db, query, falseClause, prover->model, output);
+        output.close();
+      }
+
+      verdicts[q] = (falseClause >= 0 ? "valid: " : falseClause == UnknownResult ? "unknown: " : "not valid: ") + query;
+    }
+  });
+  pool.RunRound();
+
+  for (int x = 0; x < verdicts.size(); x++)
+    cout << x + 1 << ". " << verdicts[x] << '\n';
+
+  // The counters and phase times are summed over the queries, so the phases add up CPU time, not wall time
+  for (int x = 0; x < queryStats.size(); x++)
+    stats.Add(queryStats[x]);
+  WriteStats(stats, statsFile);
 }
 
 int main(int argc, char *argv[])
 {
+  // The input file is the one argument that is not a switch:
+  //   --ratio=N   given clauses picked by weight for each one picked by age (0 = by age only)
+  //   --query=N   trailing input clauses forming the negated query and set of support (0 = no set of support)
+  //   --bitset=0  always resolve on the sorted literal arrays, even when a bitset kernel would fit
+  //   --binary=0  saturate without first reasoning on the implication graph of the binary clauses
+  //   --preprocess=0
+  //               search without first removing pure literals, subsumed clauses and eliminable atoms
+  //   --threads=N saturate with N threads (1 = the sequential loop)
+  //   --batch=F   treat the input file as the knowledge base alone and answer every query line of file F, one
+  //               query per thread (--threads=N sets the thread count, otherwise one per core)
+  //   --dimacs=1  read the input file as DIMACS CNF, which is the default for files ending in ".cnf". A DIMACS
+  //               instance has no query, so outside batch mode set of support is off unless --query is given.
+  //   --formulas=1
+  //               read the input file as one formula per line, which is the default for files ending in ".fml".
+  //               The formulas may use ->, <->, ^, v, ~ and parentheses and are converted to clauses, and the
+  //               clauses of the last formula are the set of support unless --query is given. In batch mode
+  //               the query lines are formulas as well.
+  //   --export=F  also write the input clauses to file F as DIMACS CNF
+  //   --engine=E  decide the input with engine E: "resolution" (the default) or "cdcl"
+  //   --stats=F   write counters and phase timings as JSON to file F, or to the standard output if F is "-"
+  //   --progress=S
+  //               print a progress line on the standard error every S seconds during the search
+  //   --strategy=S
+  //               resolve on every literal ("all", the default), or only on one literal per clause: the one of
+  //               its highest ranked atom ("ordered"), or its highest ranked negative literal if it has any
+  //               ("negative"). Set of support is off under the last two, since they are complete without it.
+  //   --order=O   rank atoms for --strategy by "frequency" (the default, the rarest ones highest), by "input"
+  //               order, or by the list of atom names in file O, highest first
+  //   --max-clauses=N, --max-memory=MB
+  //               bound the resolution engine's clause database, evicting unprocessed clauses when it is full.
+  //               The answer is "unknown" if an evicted clause might have been needed.
+  //   --trace=F   stream every clause the run derives to file F in the compact binary format of Trace.h
+  //   --render-trace=F
+  //               only print the proof recorded in the trace file F
+  //   --compile=F only compile the input file into the binary image F. Any command that takes an input file also
+  //               takes an image, and loads it without parsing.
+  // Proofs run to millions of lines, so the standard streams are not kept in step with C stdio
+  ios::sync_with_stdio(false);
+
+  ProverOptions options;
+  string fileName = "";
+  string batchFile = "";
+  string exportFile = "";
+  string imageFile = "";
+  string statsFile = "";
+  string traceFile = "";
+  string renderFile = "";
+  int dimacs = -1;
+  int formulas = -1;
+  bool queryGiven = false;
+
+  for (int x = 1; x < argc; x++)
+  {
+    string arg = argv[x];
+    if (ReadOption(arg, "query", options.queryClauses))
+    {
+      queryGiven = true;
+      continue;
+    }
+    if (ReadOption(arg, "ratio", options.weightRatio) || ReadOption(arg, "dimacs", dimacs) || ReadOption(arg, "formulas", formulas))
+      continue;
+    if (ReadOption(arg, "bitset", options.bitsets) || ReadOption(arg, "threads", options.threads) || ReadOption(arg, "binary", options.binaryGraph))
+      continue;
+    if (ReadOption(arg, "engine", options.engine) || ReadOption(arg, "stats", statsFile) || ReadOption(arg, "progress", options.progress))
+      continue;
+    if (ReadOption(arg, "max-clauses", options.maxClauses) || ReadOption(arg, "max-memory", options.maxMemoryMB))
+      continue;
+    if (ReadOption(arg, "batch", batchFile) || ReadOption(arg, "export", exportFile) || ReadOption(arg, "compile", imageFile))
+      continue;
+    if (ReadOption(arg, "trace", traceFile) || ReadOption(arg, "render-trace", renderFile))
+      continue;
+    if (ReadOption(arg, "strategy", options.strategy) || ReadOption(arg, "order", options.order) || ReadOption(arg, "preprocess", options.preprocess))
+      continue;
+
+    fileName = arg;
+  }
+
+  // A switch overrides the extension either way
+  InputFormat format = FormatOf(fileName);
+  if (dimacs >= 0)
+    format = dimacs ? DimacsInput : format == DimacsInput ? ClauseInput : format;
+  if (formulas >= 0)
+    format = formulas ? FormulaInput : format == FormulaInput ? ClauseInput : format;
 
+  if (format == DimacsInput && !queryGiven && batchFile.empty())
+    options.queryClauses = 0;
 
-  PartB(argv[1]);
+  if (!MakeProver(options))
+  {
+    cerr << "Unknown engine " << options.engine << endl;
+    return 1;
+  }
+  if (!IsStrategy(options.strategy))
+  {
+    cerr << "Unknown strategy " << options.strategy << endl;
+    return 1;
+  }
+
+  // Any order other than the built-in ones is a file of atom names
+  if (options.order != "input" && options.order != "frequency")
+  {
+    ifstream orderFile(options.order);
+    if (!orderFile)
+    {
+      cerr << options.order << ": cannot open file" << endl;
+      return 1;
+    }
+    string name;
+    while (orderFile >> name)
+      options.atomOrder.push_back(name);
+    options.order = "file";
+  }
+
+  if (!renderFile.empty())
+    return RenderTrace(renderFile) ? 0 : 1;
+  if (!imageFile.empty())
+    return Compile(fileName, format, imageFile) ? 0 : 1;
+
+  if (batchFile.empty())
+    PartB(fileName, options, format, queryGiven, exportFile, statsFile, traceFile);
+  else
+    PartC(fileName, batchFile, options, format, statsFile);
   cout << endl;
 
   return 0;
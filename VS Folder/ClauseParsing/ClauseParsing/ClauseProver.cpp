@@ -0,0 +1,144 @@
+// ClauseProver.cpp : the prover as a library, for programs that embed it
+//
+
+#include "stdafx.h"
+#include "ClauseProver.h"
+#include "Prover.h"
+#include "ClauseReader.h"
+#include "Dimacs.h"
+#include "Formula.h"
+
+using namespace std;
+
+ClauseProver::ClauseProver(const ProverOptions& opts)
+  : options(opts)
+{
+}
+
+int ClauseProver::AddClauses(const string& text, string* errors)
+{
+  ostringstream problems;
+  int count = ReadClauses(text.data(), text.data() + text.size(), "clauses", db, problems);
+  if (errors != NULL)
+    *errors += problems.str();
+  return count;
+}
+
+int ClauseProver::AddFormulas(const string& text, string* errors)
+{
+  ostringstream problems;
+  int last;
+  int count = ReadFormulas(text.data(), text.data() + text.size(), "formulas", db, problems, last);
+  if (errors != NULL)
+    *errors += problems.str();
+  return count;
+}
+
+int ClauseProver::AddDimacs(const string& text, string* errors)
+{
+  ostringstream problems;
+  int count = ReadDimacs(text.data(), text.data() + text.size(), "dimacs", db, problems);
+  if (errors != NULL)
+    *errors += problems.str();
+  return count;
+}
+
+ProofResult ClauseProver::Prove(const string& query) const
+{
+  ClauseDatabase copy = db;
+
+  vector<Literal> lits;
+  const char* problem = ParseClause(query.data(), query.data() + query.size(), copy.atoms, lits);
+  if (problem == NULL && lits.empty())
+    problem = "empty query";
+  if (problem != NULL)
+  {
+    ProofResult result;
+    result.error = problem;
+    return result;
+  }
+
+  // The query holds if its negation, one unit per literal, contradicts the knowledge base
+  vector<Literal> unit(1);
+  for (int x = 0; x < lits.size(); x++)
+  {
+    unit[0] = Complement(lits[x]);
+    copy.Add(unit);
+  }
+
+  return Run(copy, (int)lits.size());
+}
+
+ProofResult ClauseProver::ProveFormula(const string& query) const
+{
+  ClauseDatabase copy = db;
+
+  string negated = "~(" + query + ")";
+  int clauses;
+  const char* problem = CnfConverter(copy).Add(negated.data(), negated.data() + negated.size(), clauses);
+  if (problem != NULL)
+  {
+    ProofResult result;
+    result.error = problem;
+    return result;
+  }
+
+  // A query that is false in every model negates to no clauses at all. It then follows only from an
+  // inconsistent knowledge base, so the knowledge base is decided on its own, without a set of support.
+  return Run(copy, clauses);
+}
+
+ProofResult ClauseProver::Decide() const
+{
+  ClauseDatabase copy = db;
+  return Run(copy, options.queryClauses);
+}
+
+ProofResult ClauseProver::Run(ClauseDatabase& copy, int support) const
+{
+  ProverOptions runOptions = options;
+  runOptions.queryClauses = support;
+
+  ProofResult result;
+  unique_ptr<Prover> prover = MakeProver(runOptions);
+  if (!prover || !IsStrategy(options.strategy))
+  {
+    result.status = BadOptions;
+    result.error = !prover ? "unknown engine " + options.engine : "unknown strategy " + options.strategy;
+    return result;
+  }
+
+  int falseClause;
+  {
+    PhaseTimer timer(result.stats, "search");
+    falseClause = prover->Prove(copy);
+  }
+  result.stats.Add(prover->stats);
+  result.stats.Sample(copy);
+  result.clauses = copy.Size();
+
+  if (falseClause == UnknownResult)
+  {
+    result.status = OutOfBudget;
+    return result;
+  }
+  if (falseClause < 0)
+  {
+    result.status = NotProved;
+    result.model.swap(prover->model);
+    return result;
+  }
+
+  result.status = Proved;
+  vector<int> ids = copy.ExtractProof(falseClause);
+  result.proof.resize(ids.size());
+  for (int x = 0; x < ids.size(); x++)
+  {
+    ProofStep& step = result.proof[x];
+    step.id = ids[x];
+    step.clause = copy.Name(ids[x]);
+    step.parents[0] = copy.headers[ids[x]].parents[0];
+    step.parents[1] = copy.headers[ids[x]].parents[1];
+  }
+  return result;
+}
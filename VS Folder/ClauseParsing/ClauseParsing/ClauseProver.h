@@ -0,0 +1,93 @@
+// ClauseProver.h : the prover as a library, for programs that embed it
+//
+
+#pragma once
+
+#include "ClauseDatabase.h"
+#include "Saturation.h"
+#include "Stats.h"
+
+// What a proof attempt came to
+enum ProofStatus
+{
+  // False was derived: the query is valid, or for Decide, the clauses are unsatisfiable
+  Proved,
+  // The clauses saturated without False: the query is not valid, or the clauses are satisfiable
+  NotProved,
+  // A budget in the options stopped the search first
+  OutOfBudget,
+  // The query could not be read, see ProofResult::error
+  BadQuery,
+  // The options name an engine or strategy that does not exist, see ProofResult::error
+  BadOptions
+};
+
+// One clause of a proof. Input clauses have no parents, so both are -1.
+struct ProofStep
+{
+public:
+  int id;
+  std::string clause;
+  int parents[2];
+};
+
+// Everything a proof attempt returns, in place of the text the command line prover prints
+struct ProofResult
+{
+public:
+  ProofStatus status = BadQuery;
+
+  // The derivation of False when status is Proved, ordered by id, so each step comes after its parents
+  std::vector<ProofStep> proof;
+
+  // A countermodel when status is NotProved and the engine keeps one, see Prover::model. The atoms are those of
+  // Clauses(), followed by any the query added.
+  std::vector<signed char> model;
+
+  // The number of clauses the attempt held at the end
+  int clauses = 0;
+
+  ProverStats stats;
+
+  // What is wrong with the query or the options when status is BadQuery or BadOptions
+  std::string error;
+};
+
+// A knowledge base and the options to prove queries against it. All of the prover's state lives in the object,
+// and the clauses come from memory rather than from files, so a program can hold any number of them.
+//
+// Each proof runs on its own copy of the knowledge base and leaves the original untouched. Once the knowledge
+// base is built, any number of threads may call the proof methods of one ClauseProver at the same time.
+struct ClauseProver
+{
+public:
+  ClauseProver(const ProverOptions& options = ProverOptions());
+
+  // Add to the knowledge base: clauses one per line ("~p q"), formulas one per line ("p ^ q -> r"), or DIMACS
+  // CNF, which has to come before anything else. A malformed line is skipped, and reported in errors if it is
+  // given. Returns the number of malformed lines.
+  int AddClauses(const std::string& text, std::string* errors = NULL);
+  int AddFormulas(const std::string& text, std::string* errors = NULL);
+  int AddDimacs(const std::string& text, std::string* errors = NULL);
+
+  // The knowledge base as it stands
+  const ClauseDatabase& Clauses() const { return db; }
+
+  // Finds if the clause query ("~z y") follows from the knowledge base. Its negation, one unit per literal, is
+  // added to a copy of the knowledge base as the set of support.
+  ProofResult Prove(const std::string& query) const;
+
+  // The same for a formula query ("z -> y")
+  ProofResult ProveFormula(const std::string& query) const;
+
+  // Finds if the knowledge base itself is unsatisfiable, taking its last options.queryClauses clauses as the
+  // set of support like a single-file run does
+  ProofResult Decide() const;
+
+private:
+  ProverOptions options;
+  ClauseDatabase db;
+
+  // Runs the engine on copy with the last support clauses as the set of support and collects the result
+  ProofResult Run(ClauseDatabase& copy, int support) const;
+};
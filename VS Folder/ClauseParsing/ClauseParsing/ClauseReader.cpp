@@ -0,0 +1,175 @@
+// ClauseReader.cpp : memory-mapped, in-place parsing of clause files
+//
+
+#include "stdafx.h"
+#include "ClauseReader.h"
+
+#if defined(_WIN32)
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+#if defined(_WIN32)
+
+MappedFile::MappedFile(const string& fileName)
+  : open(false), data(""), size(0), file(INVALID_HANDLE_VALUE), mapping(NULL)
+{
+  file = CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+  if (file == INVALID_HANDLE_VALUE)
+    return;
+
+  LARGE_INTEGER length;
+  if (!GetFileSizeEx(file, &length))
+    return;
+  open = true;
+
+  // A mapping of zero bytes is not allowed, and an empty file needs none
+  if (length.QuadPart == 0)
+    return;
+
+  mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+  if (mapping != NULL)
+    data = (const char*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+
+  if (mapping == NULL || data == NULL)
+  {
+    open = false;
+    data = "";
+    return;
+  }
+  size = (size_t)length.QuadPart;
+}
+
+MappedFile::~MappedFile()
+{
+  if (size > 0)
+    UnmapViewOfFile(data);
+  if (mapping != NULL)
+    CloseHandle(mapping);
+  if (file != INVALID_HANDLE_VALUE)
+    CloseHandle(file);
+}
+
+#else
+
+MappedFile::MappedFile(const string& fileName)
+  : open(false), data(""), size(0)
+{
+  int fd = ::open(fileName.c_str(), O_RDONLY);
+  if (fd < 0)
+    return;
+
+  struct stat info;
+  if (fstat(fd, &info) == 0)
+  {
+    open = true;
+
+    // mmap refuses a length of zero, and an empty file needs no mapping
+    if (info.st_size > 0)
+    {
+      void* view = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (view == MAP_FAILED)
+        open = false;
+      else
+      {
+        madvise(view, (size_t)info.st_size, MADV_SEQUENTIAL);
+        data = (const char*)view;
+        size = (size_t)info.st_size;
+      }
+    }
+  }
+
+  // The mapping stays valid after the descriptor is closed
+  close(fd);
+}
+
+MappedFile::~MappedFile()
+{
+  if (size > 0)
+    munmap((void*)data, size);
+}
+
+#endif
+
+const char* ParseClause(const char* begin, const char* end, AtomTable& atoms, vector<Literal>& lits)
+{
+  lits.clear();
+
+  const char* p = begin;
+  while (true)
+  {
+    while (p != end && (*p == ' ' || *p == '\t' || *p == '\r'))
+      p++;
+    if (p == end)
+      break;
+
+    const char* token = p;
+    while (p != end && *p != ' ' && *p != '\t' && *p != '\r')
+      p++;
+
+    string_view name(token, p - token);
+    bool negated = name[0] == '~';
+    if (negated)
+      name.remove_prefix(1);
+
+    if (name.empty())
+      return "'~' without an atom";
+    if (name.find('~') != string_view::npos)
+      return "'~' inside an atom name";
+
+    lits.push_back(MakeLiteral(atoms.Intern(name), negated));
+  }
+
+  ClauseDatabase::Normalize(lits);
+  return NULL;
+}
+
+int ReadClauses(const char* begin, const char* end, const string& name, ClauseDatabase& db, ostream& errors)
+{
+  vector<Literal> lits;
+  int malformed = 0;
+  int lineNumber = 0;
+
+  for (const char* line = begin; line != end; )
+  {
+    const char* lineEnd = (const char*)memchr(line, '\n', end - line);
+    if (lineEnd == NULL)
+      lineEnd = end;
+    lineNumber++;
+
+    const char* problem = ParseClause(line, lineEnd, db.atoms, lits);
+    if (problem != NULL)
+    {
+      errors << name << ":" << lineNumber << ": " << problem << ", line skipped" << endl;
+      malformed++;
+    }
+
+    // A line without literals is blank, not an empty clause
+    else if (!lits.empty())
+      db.Add(lits);
+
+    line = lineEnd == end ? end : lineEnd + 1;
+  }
+
+  return malformed;
+}
+
+bool ReadClauseFile(const string& fileName, ClauseDatabase& db, ostream& errors)
+{
+  MappedFile file(fileName);
+  if (!file.IsOpen())
+  {
+    errors << fileName << ": cannot open file" << endl;
+    return false;
+  }
+
+  ReadClauses(file.Begin(), file.End(), fileName, db, errors);
+  return true;
+}
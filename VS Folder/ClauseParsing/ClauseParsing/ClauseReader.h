@@ -0,0 +1,43 @@
+// ClauseReader.h : memory-mapped, in-place parsing of clause files
+//
+
+#pragma once
+
+#include "ClauseDatabase.h"
+
+// A whole file mapped read-only into memory. The mapping lives as long as the object.
+struct MappedFile
+{
+public:
+  MappedFile(const std::string& fileName);
+  ~MappedFile();
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  bool IsOpen() const { return open; }
+  const char* Begin() const { return data; }
+  const char* End() const { return data + size; }
+
+private:
+  bool open;
+  const char* data;
+  size_t size;
+
+#if defined(_WIN32)
+  void* file;
+  void* mapping;
+#endif
+};
+
+// Scans one line of a clause file in place: literals separated by spaces or tabs, each an atom name with an
+// optional leading '~'. Interns the atoms and leaves the clause in standard form in lits. Returns NULL, or a
+// description of what is wrong with the line.
+const char* ParseClause(const char* begin, const char* end, AtomTable& atoms, std::vector<Literal>& lits);
+
+// Adds every clause of the text begin .. end to db, one per line. Blank lines are skipped. A malformed line is
+// reported on errors as "name:line: problem" and skipped. Returns the number of malformed lines.
+int ReadClauses(const char* begin, const char* end, const std::string& name, ClauseDatabase& db, std::ostream& errors);
+
+// Maps fileName and reads its clauses into db. Returns false if the file cannot be opened.
+bool ReadClauseFile(const std::string& fileName, ClauseDatabase& db, std::ostream& errors);
@@ -0,0 +1,37 @@
+// CommandLine.cpp : "--name=value" switches shared by the prover and the bench
+//
+
+#include "stdafx.h"
+#include "CommandLine.h"
+
+using namespace std;
+
+bool ReadOption(const string& arg, const string& name, int& value)
+{
+  string prefix = "--" + name + "=";
+  if (arg.compare(0, prefix.size(), prefix) != 0)
+    return false;
+
+  value = atoi(arg.c_str() + prefix.size());
+  return true;
+}
+
+bool ReadOption(const string& arg, const string& name, bool& value)
+{
+  int number = value ? 1 : 0;
+  if (!ReadOption(arg, name, number))
+    return false;
+
+  value = number != 0;
+  return true;
+}
+
+bool ReadOption(const string& arg, const string& name, string& value)
+{
+  string prefix = "--" + name + "=";
+  if (arg.compare(0, prefix.size(), prefix) != 0)
+    return false;
+
+  value = arg.substr(prefix.size());
+  return true;
+}
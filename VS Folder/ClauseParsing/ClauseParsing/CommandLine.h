@@ -0,0 +1,9 @@
+// CommandLine.h : "--name=value" switches shared by the prover and the bench
+//
+
+#pragma once
+
+// Reads a "--name=value" switch into value. Returns false if arg is some other argument. A bool takes 0 or 1.
+bool ReadOption(const std::string& arg, const std::string& name, int& value);
+bool ReadOption(const std::string& arg, const std::string& name, bool& value);
+bool ReadOption(const std::string& arg, const std::string& name, std::string& value);
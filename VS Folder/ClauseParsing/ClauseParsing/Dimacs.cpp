@@ -0,0 +1,186 @@
+// Dimacs.cpp : reading and writing clause sets in DIMACS CNF
+//
+
+#include "stdafx.h"
+#include "Dimacs.h"
+#include "ClauseReader.h"
+
+using namespace std;
+
+// The most variables an instance may have, far beyond any this prover can search, so that a damaged number
+// cannot make it intern billions of atoms
+const int MaxVariables = 1 << 26;
+
+// Makes sure atoms 0 .. variables - 1 exist, named by their variable number
+void AddVariables(AtomTable& atoms, int variables)
+{
+  while ((int)atoms.names.size() < variables)
+    atoms.Intern(to_string(atoms.names.size() + 1));
+}
+
+int ReadDimacs(const char* begin, const char* end, const string& name, ClauseDatabase& db, ostream& errors)
+{
+  vector<Literal> lits;
+  int problems = 0;
+  int lineNumber = 1;
+  int declaredClauses = -1;
+  int declaredVariables = -1;
+  int first = db.Size();
+
+  const char* p = begin;
+  while (p != end)
+  {
+    char c = *p;
+
+    if (c == '\n')
+    {
+      lineNumber++;
+      p++;
+      continue;
+    }
+
+    if (c == ' ' || c == '\t' || c == '\r')
+    {
+      p++;
+      continue;
+    }
+
+    if (c == '%')
+      break;
+
+    if (c == 'c' || c == 'p')
+    {
+      const char* lineEnd = (const char*)memchr(p, '\n', end - p);
+      if (lineEnd == NULL)
+        lineEnd = end;
+
+      if (c == 'p')
+      {
+        // Only read once per file, so a stream is fine here
+        istringstream header(string(p, lineEnd));
+        string tag, format;
+        int variables = 0;
+        if (!(header >> tag >> format >> variables >> declaredClauses) || tag != "p" || format != "cnf" || variables < 0 ||
+            variables > MaxVariables)
+        {
+          errors << name << ":" << lineNumber << ": expected \"p cnf <variables> <clauses>\" with at most " << MaxVariables
+            << " variables" << endl;
+          problems++;
+          declaredClauses = -1;
+        }
+        else
+        {
+          declaredVariables = variables;
+          AddVariables(db.atoms, variables);
+        }
+      }
+
+      p = lineEnd;
+      continue;
+    }
+
+    // A signed variable number; 0 ends the clause
+    bool negative = c == '-';
+    if (negative)
+      p++;
+
+    if (p == end || *p < '0' || *p > '9')
+    {
+      errors << name << ":" << lineNumber << ": expected a literal, clause dropped" << endl;
+      problems++;
+      lits.clear();
+      while (p != end && *p != '\n')
+        p++;
+      continue;
+    }
+
+    // The digits are all read even past the limit, which stops the value from overflowing
+    int limit = declaredVariables >= 0 ? declaredVariables : MaxVariables;
+    int variable = 0;
+    while (p != end && *p >= '0' && *p <= '9')
+    {
+      variable = variable * 10 + (*p++ - '0');
+      if (variable > limit)
+        variable = limit + 1;
+    }
+
+    if (variable > limit)
+    {
+      errors << name << ":" << lineNumber << ": variable out of range, at most " << limit << ", clause dropped" << endl;
+      problems++;
+      lits.clear();
+      while (p != end && *p != '\n')
+        p++;
+      continue;
+    }
+
+    if (variable == 0)
+    {
+      ClauseDatabase::Normalize(lits);
+      db.Add(lits);
+      lits.clear();
+      continue;
+    }
+
+    AddVariables(db.atoms, variable);
+    lits.push_back(MakeLiteral(variable - 1, negative));
+  }
+
+  if (!lits.empty())
+  {
+    errors << name << ":" << lineNumber << ": last clause has no terminating 0" << endl;
+    problems++;
+    ClauseDatabase::Normalize(lits);
+    db.Add(lits);
+  }
+
+  if (declaredClauses >= 0 && db.Size() - first != declaredClauses)
+  {
+    errors << name << ": header declares " << declaredClauses << " clauses but " << db.Size() - first << " were read" << endl;
+    problems++;
+  }
+
+  return problems;
+}
+
+bool ReadDimacsFile(const string& fileName, ClauseDatabase& db, ostream& errors)
+{
+  MappedFile file(fileName);
+  if (!file.IsOpen())
+  {
+    errors << fileName << ": cannot open file" << endl;
+    return false;
+  }
+
+  ReadDimacs(file.Begin(), file.End(), fileName, db, errors);
+  return true;
+}
+
+void WriteDimacs(const ClauseDatabase& db, const vector<int>& ids, ostream& output)
+{
+  for (int x = 0; x < db.atoms.names.size(); x++)
+  {
+    if (db.atoms.names[x] != to_string(x + 1))
+      output << "c " << x + 1 << " " << db.atoms.names[x] << '\n';
+  }
+
+  output << "p cnf " << db.atoms.names.size() << " " << ids.size() << '\n';
+
+  for (int x = 0; x < ids.size(); x++)
+  {
+    for (const Literal* l = db.Begin(ids[x]); l != db.End(ids[x]); l++)
+      output << (IsNegated(*l) ? "-" : "") << AtomOf(*l) + 1 << ' ';
+    output << "0\n";
+  }
+}
+
+bool WriteDimacsFile(const string& fileName, const ClauseDatabase& db, const vector<int>& ids)
+{
+  ofstream output;
+  output.open(fileName);
+  if (!output.is_open())
+    return false;
+
+  WriteDimacs(db, ids, output);
+  return true;
+}
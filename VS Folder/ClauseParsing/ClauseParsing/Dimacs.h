@@ -0,0 +1,23 @@
+// Dimacs.h : reading and writing clause sets in DIMACS CNF
+//
+
+#pragma once
+
+#include "ClauseDatabase.h"
+
+// Adds every clause of the DIMACS CNF text begin .. end to db. Variable v is atom v - 1, so a literal id comes
+// straight from its number without looking up any name; the atoms are named "1", "2", ... so proofs still print.
+// db must not have atoms of its own yet. Comment lines and the "p cnf" header are checked but not required, and
+// a '%' line ends the data as in the SATLIB sets. Problems are reported on errors as "name:line: problem".
+// Returns the number of problems.
+int ReadDimacs(const char* begin, const char* end, const std::string& name, ClauseDatabase& db, std::ostream& errors);
+
+// Maps fileName and reads it with ReadDimacs. Returns false if the file cannot be opened.
+bool ReadDimacsFile(const std::string& fileName, ClauseDatabase& db, std::ostream& errors);
+
+// Writes the clauses ids of db as DIMACS CNF, atom a as variable a + 1. Atoms whose name is not already their
+// variable number are listed in "c" lines first, so the file can be mapped back by hand.
+void WriteDimacs(const ClauseDatabase& db, const std::vector<int>& ids, std::ostream& output);
+
+// Writes the clauses ids of db to fileName with WriteDimacs. Returns false if the file cannot be created.
+bool WriteDimacsFile(const std::string& fileName, const ClauseDatabase& db, const std::vector<int>& ids);
@@ -0,0 +1,399 @@
+// Formula.cpp : propositional formulas in implication form, and their conversion to clauses
+//
+
+#include "stdafx.h"
+#include "Formula.h"
+
+using namespace std;
+
+const char* CnfConverter::Add(const char* begin, const char* end, int& clauses)
+{
+  clauses = 0;
+  nodes.clear();
+
+  p = begin;
+  this->end = end;
+  error = NULL;
+  depth = 0;
+  Scan();
+
+  int root = ParseIff();
+  if (root >= 0 && token != EndToken)
+    error = token == CloseToken ? "')' without a matching '('" : "operator missing between operands";
+  if (error != NULL)
+    return error;
+
+  // A conjunction at the top is asserted one conjunct at a time, and each disjunction becomes one clause
+  vector<pair<int, bool>> conjuncts;
+  vector<pair<int, bool>> parts;
+  vector<Literal> clause;
+  Flatten(root, false, true, conjuncts);
+
+  // Defining the named atoms adds clauses of its own, so count them from the database
+  defined.assign(2 * nodes.size(), NoLiteral);
+  int before = db.Size();
+  for (int x = 0; x < conjuncts.size(); x++)
+  {
+    parts.clear();
+    Flatten(conjuncts[x].first, conjuncts[x].second, false, parts);
+
+    clause.clear();
+    for (int y = 0; y < parts.size(); y++)
+      clause.push_back(Define(parts[y].first, parts[y].second));
+    AddClause(clause);
+  }
+  clauses = db.Size() - before;
+
+  return NULL;
+}
+
+void CnfConverter::Scan()
+{
+  while (p != end && (*p == ' ' || *p == '\t' || *p == '\r'))
+    p++;
+
+  tokenText = string_view();
+  if (p == end)
+  {
+    token = EndToken;
+    return;
+  }
+
+  switch (*p)
+  {
+  case '~': token = NotToken; p++; return;
+  case '^': token = AndToken; p++; return;
+  case '(': token = OpenToken; p++; return;
+  case ')': token = CloseToken; p++; return;
+  }
+
+  if (end - p >= 2 && p[0] == '-' && p[1] == '>')
+  {
+    token = ImpliesToken;
+    p += 2;
+    return;
+  }
+  if (end - p >= 3 && p[0] == '<' && p[1] == '-' && p[2] == '>')
+  {
+    token = IffToken;
+    p += 3;
+    return;
+  }
+
+  const char* start = p;
+  while (p != end && !strchr(" \t\r~^()", *p) && !(end - p >= 2 && p[0] == '-' && p[1] == '>') &&
+    !(end - p >= 3 && p[0] == '<' && p[1] == '-' && p[2] == '>'))
+    p++;
+
+  tokenText = string_view(start, p - start);
+  token = tokenText == "v" ? OrToken : AtomToken;
+}
+
+int CnfConverter::MakeNode(Kind kind, int atom, int left, int right)
+{
+  Node node;
+  node.kind = kind;
+  node.atom = atom;
+  node.left = left;
+  node.right = right;
+  nodes.push_back(node);
+  return (int)nodes.size() - 1;
+}
+
+int CnfConverter::ParseIff()
+{
+  int left = ParseImplies();
+  while (left >= 0 && token == IffToken)
+  {
+    Scan();
+    int right = ParseImplies();
+    if (right < 0)
+      return -1;
+
+    // a <-> b is (~a v b) ^ (a v ~b), sharing the nodes of a and b
+    int forward = MakeNode(OrNode, -1, MakeNode(NotNode, -1, left, -1), right);
+    int backward = MakeNode(OrNode, -1, left, MakeNode(NotNode, -1, right, -1));
+    left = MakeNode(AndNode, -1, forward, backward);
+  }
+  return left;
+}
+
+int CnfConverter::ParseImplies()
+{
+  // The operands are collected first and folded from the right, so a long chain takes no recursion
+  vector<int> operands(1, ParseOr());
+  while (operands.back() >= 0 && token == ImpliesToken)
+  {
+    Scan();
+    operands.push_back(ParseOr());
+  }
+  if (operands.back() < 0)
+    return -1;
+
+  // a -> b -> c is a -> (b -> c), and a -> b is ~a v b
+  int right = operands.back();
+  for (int x = (int)operands.size() - 2; x >= 0; x--)
+    right = MakeNode(OrNode, -1, MakeNode(NotNode, -1, operands[x], -1), right);
+  return right;
+}
+
+int CnfConverter::ParseOr()
+{
+  int left = ParseAnd();
+  while (left >= 0 && token == OrToken)
+  {
+    Scan();
+    int right = ParseAnd();
+    if (right < 0)
+      return -1;
+    left = MakeNode(OrNode, -1, left, right);
+  }
+  return left;
+}
+
+int CnfConverter::ParseAnd()
+{
+  int left = ParseUnary();
+  while (left >= 0 && token == AndToken)
+  {
+    Scan();
+    int right = ParseUnary();
+    if (right < 0)
+      return -1;
+    left = MakeNode(AndNode, -1, left, right);
+  }
+  return left;
+}
+
+int CnfConverter::ParseUnary()
+{
+  // A run of negations folds into at most one, so ~~~~a takes no recursion
+  bool negated = false;
+  while (token == NotToken)
+  {
+    negated = !negated;
+    Scan();
+  }
+
+  int operand;
+  if (token == OpenToken)
+  {
+    // Each level of parentheses recurses through every binding strength, so the levels are limited to keep
+    // deeply nested input from running out of stack
+    if (++depth > MaxNesting)
+    {
+      error = "parentheses nested too deeply";
+      return -1;
+    }
+
+    Scan();
+    operand = ParseIff();
+    depth--;
+    if (operand < 0)
+      return -1;
+    if (token != CloseToken)
+    {
+      error = "'(' without a matching ')'";
+      return -1;
+    }
+    Scan();
+  }
+  else if (token == AtomToken)
+  {
+    operand = MakeNode(AtomNode, db.atoms.Intern(tokenText), -1, -1);
+    Scan();
+  }
+  else
+  {
+    error = token == EndToken ? "formula ends where an operand was expected" : "operator where an operand was expected";
+    return -1;
+  }
+
+  return negated ? MakeNode(NotNode, -1, operand, -1) : operand;
+}
+
+void CnfConverter::Flatten(int node, bool negated, bool conjunction, vector<pair<int, bool>>& parts) const
+{
+  // An explicit stack, since a long chain such as a ^ b ^ c ^ ... parses into a tree as deep as it is long
+  vector<pair<int, bool>> pending;
+  pending.push_back(make_pair(node, negated));
+  while (!pending.empty())
+  {
+    int n = pending.back().first;
+    bool neg = pending.back().second;
+    pending.pop_back();
+
+    while (nodes[n].kind == NotNode)
+    {
+      n = nodes[n].left;
+      neg = !neg;
+    }
+
+    if (nodes[n].kind == AtomNode || IsAnd(n, neg) != conjunction)
+    {
+      parts.push_back(make_pair(n, neg));
+      continue;
+    }
+
+    // Right first, so the operands come out in the order they were written
+    pending.push_back(make_pair(nodes[n].right, neg));
+    pending.push_back(make_pair(nodes[n].left, neg));
+  }
+}
+
+Literal CnfConverter::Define(int node, bool negated)
+{
+  // Operands are defined before the subformulas that use them, on an explicit stack, since a chain of <-> or of
+  // alternating ^ and v nests as deep as it is long. Each node is defined once for each sign and remembered,
+  // which also keeps the operands that <-> shares from being defined over and over.
+  vector<pair<int, bool>> pending(1, make_pair(node, negated));
+  vector<pair<int, bool>> operands;
+  vector<Literal> parts;
+  vector<Literal> clause;
+
+  while (!pending.empty())
+  {
+    int n = pending.back().first;
+    bool neg = pending.back().second;
+    while (nodes[n].kind == NotNode)
+    {
+      n = nodes[n].left;
+      neg = !neg;
+    }
+
+    if (defined[2 * n + neg] != NoLiteral)
+    {
+      pending.pop_back();
+      continue;
+    }
+    if (nodes[n].kind == AtomNode)
+    {
+      defined[2 * n + neg] = MakeLiteral(nodes[n].atom, neg);
+      pending.pop_back();
+      continue;
+    }
+
+    bool conjunction = IsAnd(n, neg);
+    operands.clear();
+    Flatten(n, neg, conjunction, operands);
+
+    // Come back to this node once every operand has its literal
+    bool ready = true;
+    for (int x = 0; x < operands.size(); x++)
+    {
+      if (defined[2 * operands[x].first + operands[x].second] == NoLiteral)
+      {
+        pending.push_back(operands[x]);
+        ready = false;
+      }
+    }
+    if (!ready)
+      continue;
+    pending.pop_back();
+
+    parts.clear();
+    for (int x = 0; x < operands.size(); x++)
+      parts.push_back(defined[2 * operands[x].first + operands[x].second]);
+    ClauseDatabase::Normalize(parts);
+
+    // Subformulas with the same operator and operand literals share a named atom, however they were written
+    string key(1, conjunction ? '^' : 'v');
+    key.append((const char*)parts.data(), parts.size() * sizeof(Literal));
+    auto found = named.find(key);
+    if (found != named.end())
+    {
+      defined[2 * n + neg] = found->second;
+      continue;
+    }
+
+    // Operands that are named atoms themselves appear under their names, so a long name is cut short and made
+    // unique with the atom's id rather than growing with the depth of the formula
+    string name = "[";
+    for (int x = 0; x < parts.size(); x++)
+    {
+      if (x > 0)
+        name += conjunction ? " ^ " : " v ";
+      name += (IsNegated(parts[x]) ? "~" : "") + db.atoms.names[AtomOf(parts[x])];
+    }
+    if (name.size() > MaxNameLength)
+      name = name.substr(0, MaxNameLength) + " ...#" + to_string(db.atoms.names.size());
+    name += "]";
+
+    Literal atom = MakeLiteral(db.atoms.Intern(name), false);
+    named[key] = atom;
+    defined[2 * n + neg] = atom;
+
+    // The named atom only has to imply the subformula, since after pushing negations down every subformula
+    // occurs positively: ~n v (a ^ b) is the clauses ~n v a and ~n v b, and ~n v (a v b) is one clause
+    if (conjunction)
+    {
+      for (int x = 0; x < parts.size(); x++)
+      {
+        clause.assign(1, Complement(atom));
+        clause.push_back(parts[x]);
+        AddClause(clause);
+      }
+    }
+    else
+    {
+      clause = parts;
+      clause.push_back(Complement(atom));
+      AddClause(clause);
+    }
+  }
+
+  while (nodes[node].kind == NotNode)
+  {
+    node = nodes[node].left;
+    negated = !negated;
+  }
+  return defined[2 * node + negated];
+}
+
+bool CnfConverter::AddClause(vector<Literal>& clause)
+{
+  ClauseDatabase::Normalize(clause);
+
+  for (int x = 1; x < clause.size(); x++)
+  {
+    if (clause[x] == Complement(clause[x - 1]))
+      return false;
+  }
+
+  db.Add(clause);
+  return true;
+}
+
+int ReadFormulas(const char* begin, const char* end, const string& name, ClauseDatabase& db, ostream& errors, int& lastClauses)
+{
+  CnfConverter converter(db);
+  int malformed = 0;
+  int lineNumber = 0;
+  lastClauses = 0;
+
+  for (const char* line = begin; line != end; )
+  {
+    const char* lineEnd = (const char*)memchr(line, '\n', end - line);
+    if (lineEnd == NULL)
+      lineEnd = end;
+    lineNumber++;
+
+    const char* first = find_if(line, lineEnd, [](char c) { return c != ' ' && c != '\t' && c != '\r'; });
+    if (first != lineEnd && *first != '#')
+    {
+      int clauses;
+      const char* problem = converter.Add(line, lineEnd, clauses);
+      if (problem != NULL)
+      {
+        errors << name << ":" << lineNumber << ": " << problem << ", line skipped" << endl;
+        malformed++;
+      }
+      else
+        lastClauses = clauses;
+    }
+
+    line = lineEnd == end ? end : lineEnd + 1;
+  }
+
+  return malformed;
+}
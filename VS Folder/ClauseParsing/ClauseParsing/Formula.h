@@ -0,0 +1,99 @@
+// Formula.h : propositional formulas in implication form, and their conversion to clauses
+//
+
+#pragma once
+
+#include "ClauseDatabase.h"
+
+// Turns formulas such as "NoLeak ^ LowTemp -> ReactorUnitSafe" into clauses. From the loosest binding operator
+// to the tightest:
+//   a <-> b    a -> b (right associative)    a v b    a ^ b    ~a    (a)
+// An atom name is any run of characters other than blanks and "~^()" that ends before an arrow. A lone "v" is
+// always the operator, never an atom.
+//
+// The conversion is Plaisted-Greenbaum: negations are pushed down to the atoms, and each conjunction inside a
+// disjunction (or the other way round) is replaced by a new atom that implies it, so the clauses grow linearly
+// with the formula rather than exponentially as they do when v is distributed over ^. A new atom is named after
+// the subformula it stands for, such as "[LowTemp ^ NoLeak]", so proofs still read in terms of the original
+// atoms, and every occurrence of a subformula shares one atom.
+struct CnfConverter
+{
+public:
+  ClauseDatabase& db;
+
+  CnfConverter(ClauseDatabase& database) : db(database) {}
+
+  // Parses the formula in begin .. end and adds its clauses to the database, setting clauses to how many were
+  // added. Returns NULL, or a description of what is wrong with the formula, in which case no clause is added.
+  const char* Add(const char* begin, const char* end, int& clauses);
+
+private:
+  // Implication and equivalence are rewritten into these while parsing
+  enum Kind { AtomNode, NotNode, AndNode, OrNode };
+
+  struct Node
+  {
+    Kind kind;
+    int atom;
+    int left;
+    int right;
+  };
+
+  enum Token { EndToken, AtomToken, NotToken, AndToken, OrToken, ImpliesToken, IffToken, OpenToken, CloseToken };
+
+  // Names of new atoms are cut short past this length
+  static const size_t MaxNameLength = 96;
+
+  // The most levels of parentheses a formula may nest, the only construct the parser recurses on
+  static const int MaxNesting = 200;
+
+  static constexpr Literal NoLiteral = (Literal)-1;
+
+  // The formula being converted, and the literal defined for each node and sign so far
+  std::vector<Node> nodes;
+  std::vector<Literal> defined;
+
+  // The scanner's position, the token just scanned, and the first error found
+  const char* p;
+  const char* end;
+  Token token;
+  std::string_view tokenText;
+  const char* error;
+
+  // The levels of parentheses open at the scanner's position
+  int depth;
+
+  // The named atom of each subformula defined so far, keyed on its operator and its operands' literals
+  std::unordered_map<std::string, Literal> named;
+
+  void Scan();
+  int MakeNode(Kind kind, int atom, int left, int right);
+
+  // Recursive descent, one level per binding strength. Each returns the node it built, or -1 on an error. Chains
+  // of operators and negations are loops, so only parentheses recurse.
+  int ParseIff();
+  int ParseImplies();
+  int ParseOr();
+  int ParseAnd();
+  int ParseUnary();
+
+  // Whether node, negated or not, is a conjunction once negations are pushed down to the atoms
+  bool IsAnd(int node, bool negated) const { return (nodes[node].kind == AndNode) != negated; }
+
+  // Appends the operands of node (negated or not) to parts, taking it as a conjunction or a disjunction and
+  // looking through negations and nested operators of that kind. A node of the other kind, or an atom, is a
+  // single operand.
+  void Flatten(int node, bool negated, bool conjunction, std::vector<std::pair<int, bool>>& parts) const;
+
+  // The literal that stands for node, negated or not, adding the definitions of the named atoms it needs
+  Literal Define(int node, bool negated);
+
+  // Puts clause in standard form and adds it, unless it is a tautology. Returns whether it was added.
+  bool AddClause(std::vector<Literal>& clause);
+};
+
+// Adds the clauses of every formula in the text begin .. end to db, one formula per line. Blank lines and lines
+// starting with '#' are skipped. A malformed line is reported on errors as "name:line: problem" and skipped.
+// lastClauses is set to the number of clauses the last formula added, which for a query file are the negated
+// query. Returns the number of malformed lines.
+int ReadFormulas(const char* begin, const char* end, const std::string& name, ClauseDatabase& db, std::ostream& errors, int& lastClauses);
@@ -0,0 +1,110 @@
+// Generators.cpp : scalable benchmark problems
+//
+
+#include "stdafx.h"
+#include "Generators.h"
+#include "ClauseReader.h"
+
+using namespace std;
+
+// Adds one clause written as in a clause file
+static void AddClause(ClauseDatabase& db, const string& text)
+{
+  vector<Literal> lits;
+  ParseClause(text.data(), text.data() + text.size(), db.atoms, lits);
+  db.Add(lits);
+}
+
+int Pigeonhole(int holes, ClauseDatabase& db)
+{
+  auto atom = [](int pigeon, int hole) { return "p" + to_string(pigeon) + "h" + to_string(hole); };
+
+  // No two pigeons in one hole
+  for (int h = 1; h <= holes; h++)
+  {
+    for (int p = 1; p <= holes + 1; p++)
+    {
+      for (int q = p + 1; q <= holes + 1; q++)
+        AddClause(db, "~" + atom(p, h) + " ~" + atom(q, h));
+    }
+  }
+
+  // Every pigeon in some hole, the last pigeon's clause last
+  for (int p = 1; p <= holes + 1; p++)
+  {
+    string clause;
+    for (int h = 1; h <= holes; h++)
+      clause += (h == 1 ? "" : " ") + atom(p, h);
+    AddClause(db, clause);
+  }
+
+  return 1;
+}
+
+int Random3Cnf(int vars, double ratio, unsigned seed, ClauseDatabase& db)
+{
+  mt19937 random(seed);
+  int clauses = (int)(vars * ratio + 0.5);
+
+  for (int x = 1; x <= vars; x++)
+    db.atoms.Intern("v" + to_string(x));
+
+  vector<Literal> lits;
+  for (int c = 0; c < clauses; c++)
+  {
+    // Three distinct atoms with random signs
+    lits.clear();
+    while (lits.size() < 3)
+    {
+      int atom = (int)(random() % vars);
+      if (find_if(lits.begin(), lits.end(), [atom](Literal l) { return AtomOf(l) == atom; }) == lits.end())
+        lits.push_back(MakeLiteral(atom, (random() & 1) != 0));
+    }
+    sort(lits.begin(), lits.end());
+    db.Add(lits);
+  }
+
+  return 0;
+}
+
+int ImplicationChain(int length, ClauseDatabase& db)
+{
+  AddClause(db, "a0");
+  for (int x = 0; x < length; x++)
+    AddClause(db, "~a" + to_string(x) + " a" + to_string(x + 1));
+  AddClause(db, "~a" + to_string(length));
+
+  return 1;
+}
+
+int PowerPlant(int exchangers, ClauseDatabase& db)
+{
+  AddClause(db, "~NoLeak ~LowTemp ReactorUnitSafe");
+
+  string allSealed = "NoLeak";
+  string allOpen = "~l LowTemp";
+  for (int x = 1; x <= exchangers; x++)
+  {
+    string h = to_string(x);
+    allSealed += " ~NoLeakH" + h;
+    allOpen += " ~V" + h;
+
+    AddClause(db, "~okH" + h + " NoLeakH" + h);
+    AddClause(db, "okH" + h + " V" + h + " NoLeakH" + h);
+    AddClause(db, "l ~V" + h + " LowTemp");
+  }
+  AddClause(db, allSealed);
+  AddClause(db, allOpen);
+
+  // The current state
+  AddClause(db, "~l");
+  for (int x = 1; x <= exchangers; x++)
+  {
+    string h = to_string(x);
+    AddClause(db, (x % 2 == 1 ? "okH" : "~okH") + h);
+    AddClause(db, (x % 2 == 1 ? "V" : "~V") + h);
+  }
+
+  AddClause(db, "~ReactorUnitSafe");
+  return 1;
+}
@@ -0,0 +1,24 @@
+// Generators.h : scalable benchmark problems
+//
+
+#pragma once
+
+#include "ClauseDatabase.h"
+
+// Each generator adds its clauses to an empty database and returns how many of the last ones are the negated
+// query, as ProverOptions::queryClauses expects, or 0 if the problem has no query.
+
+// The pigeonhole problem task5 is a small relative of: holes + 1 pigeons that each sit in some hole, and no two
+// pigeons sharing one. Unsatisfiable, and exponentially hard for resolution. The last pigeon's clause is the query.
+int Pigeonhole(int holes, ClauseDatabase& db);
+
+// Uniform random 3-CNF with round(vars * ratio) clauses. Near the ratio 4.26 about half the instances are
+// satisfiable and they are hardest to decide.
+int Random3Cnf(int vars, double ratio, unsigned seed, ClauseDatabase& db);
+
+// a0 and a(i) -> a(i+1) for every i below length, with the query a(length). Valid, by a proof as long as the chain.
+int ImplicationChain(int length, ClauseDatabase& db);
+
+// The power plant rule set of task6 with the given number of heat exchangers. Odd exchangers are ok and their
+// valves open, even ones are neither; the query ReactorUnitSafe is valid.
+int PowerPlant(int exchangers, ClauseDatabase& db);
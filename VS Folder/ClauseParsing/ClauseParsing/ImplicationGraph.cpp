@@ -0,0 +1,248 @@
+// ImplicationGraph.cpp : the binary and unit clauses as an implication graph, for linear-time reasoning on them
+//
+
+#include "stdafx.h"
+#include "ImplicationGraph.h"
+
+using namespace std;
+
+ImplicationGraph::ImplicationGraph(ClauseDatabase& database)
+  : db(database), stamp(0)
+{
+}
+
+int ImplicationGraph::Simplify(int budget, ProverStats& stats)
+{
+  int size = db.Size();
+  Build();
+
+  int count = FindComponents();
+  vector<int> sizes(count, 0);
+  for (int l = 0; l < components.size(); l++)
+    sizes[components[l]]++;
+
+  for (Literal l = 0; l < components.size(); l += 2)
+  {
+    if (components[l] != components[l + 1])
+      continue;
+
+    // l and ~l imply each other, so both (~l) and (l) follow and resolve to False. The paths are there to be
+    // found, so the searches go unbounded.
+    int unbounded = INT_MAX;
+    Search(l, Complement(l), -1, unbounded);
+    int negative = DeriveUnit(l);
+    Search(Complement(l), l, -1, unbounded);
+    int positive = DeriveUnit(Complement(l));
+
+    vector<Literal> resolvent;
+    db.Resolve(negative, positive, resolvent);
+    return db.Add(resolvent, negative, positive);
+  }
+
+  // Each component of k literals holds k - 1 equivalences, and every one shows up once for each sign
+  uint64_t equivalences = 0;
+  for (int x = 0; x < count; x++)
+    equivalences += sizes[x] - 1;
+  stats.equivalentLiterals += equivalences / 2;
+
+  // Probe one literal of each component, since the others are equivalent to it, and none of an atom that
+  // already has a unit
+  vector<bool> probed(count, false);
+  vector<bool> fixed(components.size() / 2, false);
+  for (int x = 0; x < size; x++)
+  {
+    if (db.Length(x) == 1 && !db.IsDead(x))
+      fixed[AtomOf(*db.Begin(x))] = true;
+  }
+  for (Literal l = 0; l < components.size() && budget > 0; l++)
+  {
+    if (probed[components[l]] || fixed[AtomOf(l)] || edges[l].empty())
+      continue;
+    probed[components[l]] = true;
+
+    if (!Search(l, Complement(l), -1, budget))
+      continue;
+
+    units.push_back(DeriveUnit(l));
+    fixed[AtomOf(l)] = true;
+    stats.failedLiterals++;
+  }
+
+  // Drop the binary clauses another path already implies, one at a time, so the edges a path relies on are
+  // never dropped along with it
+  redundant.assign(size, false);
+  for (int x = 0; x < size && budget > 0; x++)
+  {
+    if (db.Length(x) != 2 || db.IsDead(x))
+      continue;
+
+    Literal a = db.Begin(x)[0];
+    Literal b = db.Begin(x)[1];
+    if (a == Complement(b) || !Search(Complement(a), b, x, budget))
+      continue;
+
+    Remove(x);
+    redundant[x] = true;
+    stats.reducedBinaries++;
+  }
+
+  return -1;
+}
+
+void ImplicationGraph::Build()
+{
+  edges.assign(2 * db.atoms.names.size(), vector<Edge>());
+
+  for (int x = 0; x < db.Size(); x++)
+  {
+    if (db.IsDead(x))
+      continue;
+
+    const Literal* l = db.Begin(x);
+    if (db.Length(x) == 1)
+      edges[Complement(l[0])].push_back(Edge{ l[0], x });
+    else if (db.Length(x) == 2 && l[0] != Complement(l[1]))
+    {
+      edges[Complement(l[0])].push_back(Edge{ l[1], x });
+      edges[Complement(l[1])].push_back(Edge{ l[0], x });
+    }
+  }
+
+  reachedFrom.resize(edges.size());
+  reachedBy.resize(edges.size());
+  mark.assign(edges.size(), 0);
+}
+
+int ImplicationGraph::FindComponents()
+{
+  int literals = (int)edges.size();
+  components.assign(literals, -1);
+
+  vector<int> index(literals, -1);
+  vector<int> low(literals, 0);
+  vector<int> stack;
+  vector<bool> onStack(literals, false);
+
+  // The recursion of Tarjan's algorithm as an explicit stack of (literal, next edge), so long implication
+  // chains cannot overflow the call stack
+  vector<pair<int, size_t>> calls;
+  int next = 0;
+  int count = 0;
+
+  for (int root = 0; root < literals; root++)
+  {
+    if (index[root] >= 0)
+      continue;
+
+    index[root] = low[root] = next++;
+    stack.push_back(root);
+    onStack[root] = true;
+    calls.push_back(make_pair(root, (size_t)0));
+
+    while (!calls.empty())
+    {
+      int v = calls.back().first;
+      if (calls.back().second < edges[v].size())
+      {
+        int w = edges[v][calls.back().second++].to;
+        if (index[w] < 0)
+        {
+          index[w] = low[w] = next++;
+          stack.push_back(w);
+          onStack[w] = true;
+          calls.push_back(make_pair(w, (size_t)0));
+        }
+        else if (onStack[w])
+          low[v] = min(low[v], index[w]);
+        continue;
+      }
+
+      calls.pop_back();
+      if (!calls.empty())
+        low[calls.back().first] = min(low[calls.back().first], low[v]);
+
+      if (low[v] != index[v])
+        continue;
+
+      int w;
+      do
+      {
+        w = stack.back();
+        stack.pop_back();
+        onStack[w] = false;
+        components[w] = count;
+      } while (w != v);
+      count++;
+    }
+  }
+
+  return count;
+}
+
+bool ImplicationGraph::Search(Literal from, Literal to, int skip, int& budget)
+{
+  stamp++;
+  mark[from] = stamp;
+
+  vector<Literal> queue(1, from);
+  for (size_t head = 0; head < queue.size(); head++)
+  {
+    Literal l = queue[head];
+    for (int x = 0; x < edges[l].size(); x++)
+    {
+      if (--budget < 0)
+        return false;
+
+      const Edge& e = edges[l][x];
+      if (e.clause == skip || mark[e.to] == stamp)
+        continue;
+
+      mark[e.to] = stamp;
+      reachedFrom[e.to] = l;
+      reachedBy[e.to] = e.clause;
+      if (e.to == to)
+        return true;
+      queue.push_back(e.to);
+    }
+  }
+
+  return false;
+}
+
+int ImplicationGraph::DeriveUnit(Literal l)
+{
+  // Walk the path back from ~l, noting each edge's clause
+  vector<int> path;
+  for (Literal at = Complement(l); at != l; at = reachedFrom[at])
+    path.push_back(reachedBy[at]);
+  reverse(path.begin(), path.end());
+
+  // After k steps the clause is (~l v m) for the literal m the path has reached, until a unit edge or the end
+  // of the path merges it into (~l)
+  vector<Literal> resolvent;
+  int current = path[0];
+  for (int x = 1; x < path.size() && db.Length(current) > 1; x++)
+  {
+    db.Resolve(current, path[x], resolvent);
+    current = db.Add(resolvent, current, path[x]);
+  }
+
+  return current;
+}
+
+void ImplicationGraph::Remove(int id)
+{
+  for (const Literal* l = db.Begin(id); l != db.End(id); l++)
+  {
+    vector<Edge>& list = edges[Complement(*l)];
+    for (int x = 0; x < list.size(); x++)
+    {
+      if (list[x].clause == id)
+      {
+        list[x] = list.back();
+        list.pop_back();
+        break;
+      }
+    }
+  }
+}
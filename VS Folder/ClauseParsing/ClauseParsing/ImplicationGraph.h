@@ -0,0 +1,74 @@
+// ImplicationGraph.h : the binary and unit clauses as an implication graph, for linear-time reasoning on them
+//
+
+#pragma once
+
+#include "ClauseDatabase.h"
+#include "Stats.h"
+
+// Every binary clause (a v b) is the two implications ~a -> b and ~b -> a, and a unit clause (a) is the one
+// implication ~a -> a. Each edge keeps the id of its clause, so a path through the graph can be turned back into
+// resolution steps: the clauses along a path from l to m resolve, one after the other, into (~l v m).
+//
+// A strongly connected component is a set of equivalent literals. If a literal shares its component with its
+// complement, the clauses are unsatisfiable; if none does, the binary and unit clauses are satisfiable on their
+// own, which decides 2-SAT in linear time. A literal from which its complement can be reached has failed, and
+// its complement follows as a unit. A binary clause whose implication is also a path through the other edges is
+// redundant.
+//
+// Only the clauses a conclusion needs are ever stored, once the graph has found it: the resolvents along one
+// path, rather than every resolvent of every pair of binary clauses.
+struct ImplicationGraph
+{
+public:
+  ClauseDatabase& db;
+
+  // The units derived from failed literals, as clause ids
+  std::vector<int> units;
+
+  // The binary clauses transitive reduction found redundant, by clause id
+  std::vector<bool> redundant;
+
+  ImplicationGraph(ClauseDatabase& database);
+
+  // Builds the graph from the database's clauses and draws every conclusion it can: a refutation, the failed
+  // literals and the redundant binary clauses. Probing and reduction stop after about budget edge visits.
+  // Returns the id of the False clause, or -1.
+  int Simplify(int budget, ProverStats& stats);
+
+private:
+  struct Edge
+  {
+    Literal to;
+    int clause;
+  };
+
+  // Outgoing edges of each literal
+  std::vector<std::vector<Edge>> edges;
+
+  // The strongly connected component of each literal. Components are numbered in reverse topological order.
+  std::vector<int> components;
+
+  // Breadth-first search state: the literal each literal was reached from and the clause of that edge, valid
+  // where mark equals stamp
+  std::vector<Literal> reachedFrom;
+  std::vector<int> reachedBy;
+  std::vector<int> mark;
+  int stamp;
+
+  // Adds the edges of every unit and binary clause in the database
+  void Build();
+
+  // Numbers the strongly connected components with Tarjan's algorithm and returns how many there are
+  int FindComponents();
+
+  // Searches from literal from for literal to without using clause skip, visiting at most budget edges, which
+  // it counts down. Returns true if to was reached, in which case reachedFrom and reachedBy hold the path.
+  bool Search(Literal from, Literal to, int skip, int& budget);
+
+  // Resolves the clauses along the path Search found from l to ~l into the unit (~l) and returns its id
+  int DeriveUnit(Literal l);
+
+  // Removes the edges of clause id
+  void Remove(int id);
+};
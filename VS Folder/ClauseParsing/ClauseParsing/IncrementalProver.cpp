@@ -0,0 +1,51 @@
+// IncrementalProver.cpp : a prover that keeps its work between proofs, with push/pop scopes
+//
+
+#include "stdafx.h"
+#include "IncrementalProver.h"
+
+using namespace std;
+
+IncrementalProver::IncrementalProver(const ProverOptions& options)
+  : saturation(db, options), refutation(-1)
+{
+  // Scopes refer to clause ids, so the database is never collected here. Set of support would keep the rules
+  // from ever meeting each other, so it is off and every clause is queued as a given clause.
+  saturation.options.queryClauses = 0;
+  saturation.options.threads = 1;
+  saturation.options.maxClauses = 0;
+  saturation.options.maxMemoryMB = 0;
+}
+
+int IncrementalProver::Add(const vector<Literal>& lits)
+{
+  int id = db.Add(lits);
+
+  int conflict = saturation.Input(id, true);
+  if (conflict >= 0 && refutation < 0)
+    refutation = conflict;
+
+  return id;
+}
+
+void IncrementalProver::Push()
+{
+  db.Push();
+}
+
+void IncrementalProver::Pop()
+{
+  saturation.Pop(db.Pop());
+
+  if (refutation >= 0 && db.IsDead(refutation))
+    refutation = -1;
+}
+
+int IncrementalProver::Prove()
+{
+  if (refutation >= 0)
+    return refutation;
+
+  refutation = saturation.Continue();
+  return refutation;
+}
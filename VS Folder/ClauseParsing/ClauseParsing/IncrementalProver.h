@@ -0,0 +1,44 @@
+// IncrementalProver.h : a prover that keeps its work between proofs, with push/pop scopes
+//
+
+#pragma once
+
+#include "ClauseDatabase.h"
+#include "Saturation.h"
+
+// Proves one query after another against a knowledge base that changes a little at a time. Permanent rules are
+// added at scope 0; state and query clauses go in a scope opened with Push and thrown away with Pop.
+//
+// Nothing is restarted between proofs. Pop kills only the clauses that depend on the closed scope (see
+// ClauseDatabase::Push), so resolvents of the permanent rules, the processed set built from them and the units
+// they propagate all carry over, and re-proving after a small change only does the work that change causes.
+//
+// For the resolvents of the rules to be there at all, the rules have to be resolved against each other, so set
+// of support is always off: options.queryClauses is ignored and every clause is a given clause.
+//
+// The atom count can grow with every scope, so this always uses the sorted-array kernel.
+struct IncrementalProver
+{
+public:
+  ClauseDatabase db;
+
+  IncrementalProver(const ProverOptions& options);
+
+  // Adds a clause in standard form to the current scope and returns its id. Clauses added at scope 0 are
+  // permanent rules.
+  int Add(const std::vector<Literal>& lits);
+
+  void Push();
+  void Pop();
+
+  int Scope() const { return db.scope; }
+
+  // Saturates the current clauses. Returns the id of the False clause, or -1 if they are satisfiable.
+  int Prove();
+
+private:
+  Saturation<SortedKernel> saturation;
+
+  // The False clause found so far, while it stays alive
+  int refutation;
+};
@@ -0,0 +1,165 @@
+// KnowledgeBase.cpp : compiled binary images of a clause database
+//
+
+#include "stdafx.h"
+#include "KnowledgeBase.h"
+
+using namespace std;
+
+// Bytes of padding that bring size up to the next multiple of 8
+size_t Padding(size_t size)
+{
+  return (8 - size % 8) % 8;
+}
+
+bool IsImage(const char* begin, const char* end)
+{
+  uint32_t magic;
+  if (end - begin < sizeof(magic))
+    return false;
+
+  memcpy(&magic, begin, sizeof(magic));
+  return magic == ImageHeader::Magic;
+}
+
+bool WriteImage(const string& fileName, const ClauseDatabase& db, bool signatures)
+{
+  ofstream output(fileName, ios::binary);
+  if (!output.is_open())
+    return false;
+
+  vector<uint32_t> nameOffsets(1, 0);
+  for (int x = 0; x < db.atoms.names.size(); x++)
+    nameOffsets.push_back(nameOffsets.back() + (uint32_t)db.atoms.names[x].size());
+
+  ImageHeader h;
+  h.magic = ImageHeader::Magic;
+  h.version = ImageHeader::Version;
+  h.flags = signatures ? ImageSignatures : 0;
+  h.headerSize = sizeof(ImageHeader);
+  h.literalSize = sizeof(Literal);
+  h.clauseHeaderSize = sizeof(ClauseHeader);
+  h.atomCount = (uint32_t)db.atoms.names.size();
+  h.clauseCount = (uint32_t)db.Size();
+  h.nameBytes = nameOffsets.back();
+  h.poolSize = db.pool.size();
+
+  const char zeros[8] = {};
+  output.write((const char*)&h, sizeof(h));
+  output.write(zeros, Padding(sizeof(h)));
+
+  output.write((const char*)nameOffsets.data(), nameOffsets.size() * sizeof(uint32_t));
+  output.write(zeros, Padding(nameOffsets.size() * sizeof(uint32_t)));
+
+  for (int x = 0; x < db.atoms.names.size(); x++)
+    output.write(db.atoms.names[x].data(), db.atoms.names[x].size());
+  output.write(zeros, Padding(h.nameBytes));
+
+  output.write((const char*)db.pool.data(), db.pool.size() * sizeof(Literal));
+  output.write(zeros, Padding(db.pool.size() * sizeof(Literal)));
+
+  output.write((const char*)db.headers.data(), db.headers.size() * sizeof(ClauseHeader));
+  output.write(zeros, Padding(db.headers.size() * sizeof(ClauseHeader)));
+
+  if (signatures)
+    output.write((const char*)db.signatures.data(), db.signatures.size() * sizeof(uint64_t));
+
+  return output.good();
+}
+
+// Copies the next section of count items out of the image, moving p past it and its padding. Returns false if
+// the image ends first.
+template <class T>
+bool ReadSection(const char*& p, const char* end, size_t count, vector<T>& items)
+{
+  size_t bytes = count * sizeof(T);
+  if (end - p < bytes)
+    return false;
+
+  items.resize(count);
+  memcpy(items.data(), p, bytes);
+  p += min((size_t)(end - p), bytes + Padding(bytes));
+  return true;
+}
+
+bool LoadImage(const char* begin, const char* end, const string& name, ClauseDatabase& db, ostream& errors)
+{
+  ImageHeader h;
+  if (end - begin < sizeof(h))
+  {
+    errors << name << ": image header is cut short" << endl;
+    return false;
+  }
+  memcpy(&h, begin, sizeof(h));
+
+  // Images are only read back by a build with the same layout, so any difference means recompiling
+  if (h.magic != ImageHeader::Magic || h.version != ImageHeader::Version || h.headerSize != sizeof(ImageHeader) ||
+      h.literalSize != sizeof(Literal) || h.clauseHeaderSize != sizeof(ClauseHeader))
+  {
+    errors << name << ": image version " << h.version << " does not match this build (version " << ImageHeader::Version
+      << "), compile the knowledge base again" << endl;
+    return false;
+  }
+
+  const char* p = begin + sizeof(h) + Padding(sizeof(h));
+  vector<uint32_t> nameOffsets;
+  vector<char> nameBytes;
+
+  bool complete = ReadSection(p, end, h.atomCount + 1, nameOffsets) && ReadSection(p, end, h.nameBytes, nameBytes) &&
+    ReadSection(p, end, h.poolSize, db.pool) && ReadSection(p, end, h.clauseCount, db.headers);
+
+  if (complete && (h.flags & ImageSignatures))
+    complete = ReadSection(p, end, h.clauseCount, db.signatures);
+
+  if (!complete)
+  {
+    errors << name << ": image is cut short" << endl;
+    db.Release();
+    return false;
+  }
+
+  // A damaged image must not send Begin and End outside the arrays, nor a literal, a parent or a level outside
+  // the atom table, the clauses before it or the scopes. The image is loaded at scope 0, so every clause is
+  // either permanent or dead. The literals of a clause must also be in standard form, strictly increasing, since
+  // resolution, subsumption and ClauseSet all rely on it.
+  bool consistent = nameOffsets.back() <= h.nameBytes;
+  for (uint32_t x = 0; x < h.atomCount && consistent; x++)
+    consistent = nameOffsets[x] <= nameOffsets[x + 1];
+  for (int x = 0; x < db.Size() && consistent; x++)
+  {
+    const ClauseHeader& c = db.headers[x];
+    consistent = (uint64_t)c.offset + c.length <= h.poolSize && c.id == x && (c.level == 0 || c.level == ClauseDatabase::DeadLevel);
+    for (int i = 0; i < 2 && consistent; i++)
+      consistent = c.parents[i] >= -1 && c.parents[i] < x && (c.parents[i] < 0) == (c.parents[0] < 0);
+    for (uint32_t i = 1; i < c.length && consistent; i++)
+      consistent = db.pool[c.offset + i - 1] < db.pool[c.offset + i];
+  }
+  for (uint32_t x = 0; x < h.poolSize && consistent; x++)
+    consistent = AtomOf(db.pool[x]) < h.atomCount;
+
+  // Two atoms with the same name would be merged into one, leaving literals past the end of the atom table
+  if (consistent)
+  {
+    db.atoms.names.reserve(h.atomCount);
+    db.atoms.ids.reserve(h.atomCount);
+    for (uint32_t x = 0; x < h.atomCount; x++)
+      db.atoms.Intern(string_view(nameBytes.data() + nameOffsets[x], nameOffsets[x + 1] - nameOffsets[x]));
+    consistent = db.atoms.names.size() == h.atomCount;
+  }
+
+  if (!consistent)
+  {
+    errors << name << ": image is damaged" << endl;
+    db.Release();
+    return false;
+  }
+
+  if (!(h.flags & ImageSignatures))
+  {
+    db.signatures.resize(h.clauseCount);
+    for (int x = 0; x < db.Size(); x++)
+      db.signatures[x] = ClauseDatabase::Signature(db.Begin(x), db.End(x));
+  }
+
+  return true;
+}
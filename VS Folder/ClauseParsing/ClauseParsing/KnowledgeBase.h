@@ -0,0 +1,40 @@
+// KnowledgeBase.h : compiled binary images of a clause database
+//
+
+#pragma once
+
+#include "ClauseDatabase.h"
+
+// Layout of a compiled image. The header is followed by the sections in this order, each starting on an 8 byte
+// boundary: the atom name offsets (atomCount + 1 uint32 values into the name bytes), the name bytes, the literal
+// pool, the clause headers and, if ImageSignatures is set, the clause signatures. Everything is stored exactly
+// as ClauseDatabase holds it in memory, so loading is a bulk copy per section.
+struct ImageHeader
+{
+public:
+  static const uint32_t Magic = 0x424b4c43; // "CLKB"
+  static const uint32_t Version = 1;
+
+  uint32_t magic;
+  uint32_t version;
+  uint32_t flags;
+  uint32_t headerSize;
+  uint32_t literalSize;
+  uint32_t clauseHeaderSize;
+  uint32_t atomCount;
+  uint32_t clauseCount;
+  uint64_t nameBytes;
+  uint64_t poolSize;
+};
+
+const uint32_t ImageSignatures = 1;
+
+// Finds if begin .. end starts like a compiled image of any version
+bool IsImage(const char* begin, const char* end);
+
+// Writes the atoms and clauses of db to fileName as an image. Returns false if the file cannot be written.
+bool WriteImage(const std::string& fileName, const ClauseDatabase& db, bool signatures = true);
+
+// Fills db, which must be empty, from the image begin .. end. Signatures missing from the image are
+// recomputed. Returns false, after reporting on errors, if the image is of another version or is cut short.
+bool LoadImage(const char* begin, const char* end, const std::string& name, ClauseDatabase& db, std::ostream& errors);
@@ -0,0 +1,144 @@
+// Parallel.cpp : the thread pool, work queues and concurrent clause set used by parallel saturation
+//
+
+#include "stdafx.h"
+#include "Parallel.h"
+
+using namespace std;
+
+WorkerPool::WorkerPool(int workers, function<void(int)> j)
+  : job(j), generation(0), running(0), stopping(false)
+{
+  for (int x = 1; x < workers; x++)
+    threads.push_back(thread(&WorkerPool::Loop, this, x));
+}
+
+WorkerPool::~WorkerPool()
+{
+  {
+    lock_guard<mutex> guard(lock);
+    stopping = true;
+  }
+  wake.notify_all();
+
+  for (int x = 0; x < threads.size(); x++)
+    threads[x].join();
+}
+
+void WorkerPool::RunRound()
+{
+  {
+    lock_guard<mutex> guard(lock);
+    generation++;
+    running = (int)threads.size();
+  }
+  wake.notify_all();
+
+  job(0);
+
+  unique_lock<mutex> guard(lock);
+  finished.wait(guard, [this] { return running == 0; });
+}
+
+void WorkerPool::Loop(int worker)
+{
+  int seenGeneration = 0;
+
+  while (true)
+  {
+    {
+      unique_lock<mutex> guard(lock);
+      wake.wait(guard, [&] { return stopping || generation != seenGeneration; });
+      if (stopping)
+        return;
+      seenGeneration = generation;
+    }
+
+    job(worker);
+
+    bool last;
+    {
+      lock_guard<mutex> guard(lock);
+      last = --running == 0;
+    }
+    if (last)
+      finished.notify_one();
+  }
+}
+
+WorkQueues::WorkQueues(int workers)
+{
+  for (int x = 0; x < workers; x++)
+    queues.push_back(unique_ptr<Queue>(new Queue()));
+}
+
+void WorkQueues::Push(int worker, int item)
+{
+  lock_guard<mutex> guard(queues[worker]->lock);
+  queues[worker]->items.push_back(item);
+}
+
+bool WorkQueues::Pop(int worker, int& item)
+{
+  {
+    Queue& own = *queues[worker];
+    lock_guard<mutex> guard(own.lock);
+    if (!own.items.empty())
+    {
+      item = own.items.front();
+      own.items.pop_front();
+      return true;
+    }
+  }
+
+  // Steal from the back of the other workers' deques, starting with the next worker along
+  for (int x = 1; x < queues.size(); x++)
+  {
+    Queue& victim = *queues[(worker + x) % queues.size()];
+    lock_guard<mutex> guard(victim.lock);
+    if (!victim.items.empty())
+    {
+      item = victim.items.back();
+      victim.items.pop_back();
+      return true;
+    }
+  }
+
+  return false;
+}
+
+ConcurrentClauseSet::ConcurrentClauseSet(int shardCount)
+{
+  for (int x = 0; x < shardCount; x++)
+    shards.push_back(unique_ptr<Shard>(new Shard()));
+}
+
+bool ConcurrentClauseSet::Insert(const vector<Literal>& lits)
+{
+  uint64_t h = ClauseSet::Hash(lits.data(), lits.data() + lits.size());
+
+  // The low bits pick the slot inside ClauseSet, so use the high bits to pick the shard
+  Shard& shard = *shards[(h >> 40) % shards.size()];
+  lock_guard<mutex> guard(shard.lock);
+
+  auto range = shard.entries.equal_range(h);
+  for (auto e = range.first; e != range.second; e++)
+  {
+    const Literal* stored = shard.pool.data() + e->second.first;
+    if (e->second.second == lits.size() && equal(lits.begin(), lits.end(), stored))
+      return false;
+  }
+
+  shard.entries.insert(make_pair(h, make_pair((uint32_t)shard.pool.size(), (uint32_t)lits.size())));
+  shard.pool.insert(shard.pool.end(), lits.begin(), lits.end());
+  return true;
+}
+
+void ConcurrentClauseSet::Clear()
+{
+  for (int x = 0; x < shards.size(); x++)
+  {
+    shards[x]->entries.clear();
+    shards[x]->pool.clear();
+  }
+}
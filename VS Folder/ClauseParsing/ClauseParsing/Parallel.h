@@ -0,0 +1,77 @@
+// Parallel.h : the thread pool, work queues and concurrent clause set used by parallel saturation
+//
+
+#pragma once
+
+#include "ClauseDatabase.h"
+
+// A fixed set of worker threads that all run the same job, one round at a time. The thread calling RunRound
+// takes part as worker 0, so a pool of N workers starts N - 1 threads.
+struct WorkerPool
+{
+public:
+  WorkerPool(int workers, std::function<void(int)> job);
+  ~WorkerPool();
+
+  int Workers() const { return (int)threads.size() + 1; }
+
+  // Runs the job once on every worker and returns when all of them have finished
+  void RunRound();
+
+private:
+  std::function<void(int)> job;
+  std::vector<std::thread> threads;
+  std::mutex lock;
+  std::condition_variable wake;
+  std::condition_variable finished;
+  int generation;
+  int running;
+  bool stopping;
+
+  void Loop(int worker);
+};
+
+// One deque of work items per worker. A worker takes items from the front of its own deque and, once that is
+// empty, steals from the back of the others, so an uneven split of work evens itself out.
+struct WorkQueues
+{
+public:
+  WorkQueues(int workers);
+
+  void Push(int worker, int item);
+
+  // Takes the next item for worker. Returns false when every deque is empty.
+  bool Pop(int worker, int& item);
+
+private:
+  struct Queue
+  {
+    std::mutex lock;
+    std::deque<int> items;
+  };
+
+  std::vector<std::unique_ptr<Queue>> queues;
+};
+
+// Set of literal arrays that many threads can insert into at once. It is split into shards by hash, each with
+// its own lock and its own literal pool, so threads only contend when their clauses land in the same shard.
+struct ConcurrentClauseSet
+{
+public:
+  ConcurrentClauseSet(int shardCount = 64);
+
+  // Adds lits, which must be in standard form. Returns false if an equal clause was already in the set.
+  bool Insert(const std::vector<Literal>& lits);
+
+  void Clear();
+
+private:
+  struct Shard
+  {
+    std::mutex lock;
+    std::unordered_multimap<uint64_t, std::pair<uint32_t, uint32_t>> entries;
+    std::vector<Literal> pool;
+  };
+
+  std::vector<std::unique_ptr<Shard>> shards;
+};
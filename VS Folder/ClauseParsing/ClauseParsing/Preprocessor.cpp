@@ -0,0 +1,332 @@
+// Preprocessor.cpp : simplification of the input clauses before the search
+//
+
+#include "stdafx.h"
+#include "Preprocessor.h"
+
+using namespace std;
+
+// An atom that occurs in more clause pairs than this is left alone, since it is the least likely to pass the
+// bound and the most expensive to try
+static const int MaxEliminationPairs = 400;
+
+Preprocessor::Preprocessor(ClauseDatabase& database)
+  : db(database)
+{
+}
+
+int Preprocessor::Simplify(vector<int>& ids, vector<bool>& support, int budget, ProverStats& stats)
+{
+  size_t literals = 2 * db.atoms.names.size();
+  occurs.assign(literals, vector<int>());
+  counts.assign(literals, 0);
+  marks.assign(literals, false);
+  active.assign(db.Size(), false);
+  supports.assign(db.Size(), false);
+
+  for (int x = 0; x < ids.size(); x++)
+  {
+    int id = ids[x];
+    if (db.Length(id) == 0)
+      return id;
+
+    bool tautology = false;
+    for (const Literal* l = db.Begin(id) + 1; l < db.End(id); l++)
+      tautology = tautology || *l == Complement(l[-1]);
+    if (tautology)
+    {
+      stats.tautologies++;
+      continue;
+    }
+
+    if (!Add(id, support[x]))
+      stats.duplicates++;
+  }
+
+  // Pure literals go first, since they only ever remove clauses
+  for (int atom = 0; atom < literals / 2; atom++)
+    touched.push_back(atom);
+  RemovePure(stats);
+
+  // Every clause is tried for subsumption once, and so is every resolvent as it is added
+  int subsumeBudget = budget;
+  size_t next = 0;
+  for (; next < added.size() && subsumeBudget > 0; next++)
+  {
+    if (!active[added[next]])
+      continue;
+    int conflict = Subsume(added[next], subsumeBudget, stats);
+    if (conflict >= 0)
+      return conflict;
+  }
+
+  // Eliminate the atoms with the fewest occurrences first, since they are the cheapest to try and the most
+  // likely to pass
+  vector<int> order;
+  for (int atom = 0; atom < literals / 2; atom++)
+  {
+    if (counts[2 * atom] > 0 && counts[2 * atom + 1] > 0)
+      order.push_back(atom);
+  }
+  sort(order.begin(), order.end(), [this](int a, int b)
+  {
+    return counts[2 * a] + counts[2 * a + 1] < counts[2 * b] + counts[2 * b + 1];
+  });
+
+  int eliminateBudget = budget;
+  for (int x = 0; x < order.size() && eliminateBudget > 0; x++)
+  {
+    int conflict = Eliminate(order[x], eliminateBudget, stats);
+    if (conflict >= 0)
+      return conflict;
+  }
+
+  RemovePure(stats);
+  for (; next < added.size() && subsumeBudget > 0; next++)
+  {
+    if (!active[added[next]])
+      continue;
+    int conflict = Subsume(added[next], subsumeBudget, stats);
+    if (conflict >= 0)
+      return conflict;
+  }
+  RemovePure(stats);
+
+  ids.clear();
+  support.clear();
+  for (int x = 0; x < active.size(); x++)
+  {
+    if (!active[x])
+      continue;
+    ids.push_back(x);
+    support.push_back(supports[x]);
+  }
+
+  // Only the reconstruction stack is needed from here on
+  occurs = vector<vector<int>>();
+  seen = ClauseSet();
+  return -1;
+}
+
+void Preprocessor::Extend(vector<signed char>& model) const
+{
+  // Undo in reverse: each clause was dropped when everything dropped after it still had a way to be satisfied
+  for (int x = (int)stack.size() - 1; x >= 0; x--)
+  {
+    int id = stack[x].clause;
+    bool satisfied = false;
+    for (const Literal* l = db.Begin(id); l != db.End(id) && !satisfied; l++)
+      satisfied = model[AtomOf(*l)] == (IsNegated(*l) ? -1 : 1);
+
+    if (!satisfied)
+      model[AtomOf(stack[x].witness)] = IsNegated(stack[x].witness) ? -1 : 1;
+  }
+}
+
+bool Preprocessor::Add(int id, bool support)
+{
+  int existing = seen.Find(db, db.Begin(id), db.End(id));
+  if (existing >= 0)
+  {
+    supports[existing] = supports[existing] || support;
+    return false;
+  }
+
+  if (id >= active.size())
+  {
+    active.resize(id + 1, false);
+    supports.resize(id + 1, false);
+  }
+  active[id] = true;
+  supports[id] = support;
+
+  for (const Literal* l = db.Begin(id); l != db.End(id); l++)
+  {
+    occurs[*l].push_back(id);
+    counts[*l]++;
+  }
+  seen.Insert(db, id);
+  added.push_back(id);
+  return true;
+}
+
+void Preprocessor::Remove(int id)
+{
+  active[id] = false;
+  seen.Erase(db, id);
+
+  for (const Literal* l = db.Begin(id); l != db.End(id); l++)
+  {
+    counts[*l]--;
+    touched.push_back(AtomOf(*l));
+  }
+}
+
+int Preprocessor::AddResolvent(int a, int b)
+{
+  db.Resolve(a, b, resolvent);
+
+  int existing = seen.Find(db, resolvent);
+  if (existing >= 0)
+  {
+    supports[existing] = supports[existing] || supports[a] || supports[b];
+    return existing;
+  }
+
+  int id = db.Add(resolvent, a, b);
+  Add(id, supports[a] || supports[b]);
+  return id;
+}
+
+void Preprocessor::RemovePure(ProverStats& stats)
+{
+  while (!touched.empty())
+  {
+    Literal l = MakeLiteral(touched.back(), false);
+    touched.pop_back();
+
+    Literal pure;
+    if (counts[l] > 0 && counts[Complement(l)] == 0)
+      pure = l;
+    else if (counts[Complement(l)] > 0 && counts[l] == 0)
+      pure = Complement(l);
+    else
+      continue;
+
+    // Setting the pure literal true satisfies all of its clauses and falsifies none
+    stats.pureLiterals++;
+    for (int x = 0; x < occurs[pure].size(); x++)
+    {
+      int id = occurs[pure][x];
+      if (!active[id])
+        continue;
+      stack.push_back(Removed{ pure, id });
+      Remove(id);
+    }
+  }
+}
+
+int Preprocessor::Subsume(int id, int& budget, ProverStats& stats)
+{
+  int length = db.Length(id);
+  Literal fewest = *db.Begin(id);
+  for (const Literal* l = db.Begin(id); l != db.End(id); l++)
+  {
+    marks[*l] = true;
+    if (counts[*l] < counts[fewest])
+      fewest = *l;
+  }
+
+  int conflict = -1;
+
+  // A clause id subsumes contains every one of its literals, so the shortest occurrence list is enough
+  for (int x = 0; x < occurs[fewest].size() && budget > 0; x++)
+  {
+    int other = occurs[fewest][x];
+    if (other == id || !active[other] || db.Length(other) < length || (db.signatures[id] & ~db.signatures[other]) != 0)
+      continue;
+
+    int found = 0;
+    for (const Literal* l = db.Begin(other); l != db.End(other); l++)
+      found += marks[*l];
+    budget -= db.Length(other);
+
+    // The subsuming clause takes over the support of the one it drops, so the set of support never loses a
+    // clause it needs
+    if (found == length)
+    {
+      supports[id] = supports[id] || supports[other];
+      Remove(other);
+      stats.subsumedInputs++;
+    }
+  }
+
+  // (l v R) strengthens every clause that holds ~l and all of R to the resolvent without ~l
+  for (int i = 0; i < length && budget > 0 && conflict < 0; i++)
+  {
+    Literal l = db.Begin(id)[i];
+    for (int x = 0; x < occurs[Complement(l)].size() && budget > 0; x++)
+    {
+      int other = occurs[Complement(l)][x];
+      if (!active[other] || db.Length(other) < length)
+        continue;
+
+      int found = 0;
+      for (const Literal* m = db.Begin(other); m != db.End(other); m++)
+        found += marks[*m];
+      budget -= db.Length(other);
+      if (found != length - 1)
+        continue;
+
+      int result = AddResolvent(id, other);
+      Remove(other);
+      stats.strengthenedClauses++;
+
+      if (db.Length(result) == 0)
+      {
+        conflict = result;
+        break;
+      }
+    }
+  }
+
+  for (const Literal* l = db.Begin(id); l != db.End(id); l++)
+    marks[*l] = false;
+  return conflict;
+}
+
+int Preprocessor::Eliminate(int atom, int& budget, ProverStats& stats)
+{
+  Literal positive = MakeLiteral(atom, false);
+  Literal negative = Complement(positive);
+  if (counts[positive] == 0 || counts[negative] == 0 || (int64_t)counts[positive] * counts[negative] > MaxEliminationPairs)
+    return -1;
+
+  vector<int> sides[2];
+  for (int s = 0; s < 2; s++)
+  {
+    const vector<int>& list = occurs[s == 0 ? positive : negative];
+    for (int x = 0; x < list.size(); x++)
+    {
+      if (active[list[x]])
+        sides[s].push_back(list[x]);
+    }
+  }
+
+  // Count the resolvents that are not tautologies, and give up as soon as they outnumber the clauses
+  size_t bound = sides[0].size() + sides[1].size();
+  vector<pair<int, int>> pairs;
+  for (int a = 0; a < sides[0].size(); a++)
+  {
+    for (int b = 0; b < sides[1].size(); b++)
+    {
+      budget -= db.Length(sides[0][a]) + db.Length(sides[1][b]);
+      if (budget < 0)
+        return -1;
+
+      if (!db.Resolve(sides[0][a], sides[1][b], resolvent))
+        continue;
+      if (pairs.size() == bound)
+        return -1;
+      pairs.push_back(make_pair(sides[0][a], sides[1][b]));
+    }
+  }
+
+  stats.eliminatedAtoms++;
+  for (int x = 0; x < pairs.size(); x++)
+  {
+    int result = AddResolvent(pairs[x].first, pairs[x].second);
+    if (db.Length(result) == 0)
+      return result;
+  }
+
+  for (int s = 0; s < 2; s++)
+  {
+    for (int x = 0; x < sides[s].size(); x++)
+    {
+      stack.push_back(Removed{ s == 0 ? positive : negative, sides[s][x] });
+      Remove(sides[s][x]);
+    }
+  }
+  return -1;
+}
@@ -0,0 +1,86 @@
+// Preprocessor.h : simplification of the input clauses before the search
+//
+
+#pragma once
+
+#include "ClauseDatabase.h"
+#include "Stats.h"
+
+// Shrinks the input before an engine searches it, SatELite style, on occurrence lists of the clause ids:
+//   - tautologies and duplicate clauses are dropped
+//   - a clause with a pure literal, one whose atom never occurs with the other sign, is dropped
+//   - a clause another clause subsumes is dropped, and one another clause strengthens by self-subsuming
+//     resolution, (l v R) against (~l v R v S), is replaced by the shorter resolvent (R v S)
+//   - an atom is eliminated by replacing every clause it occurs in with all of their resolvents on it, as long
+//     as that gives no more clauses than it removes (bounded variable elimination)
+//
+// Every new clause is an ordinary resolvent, added to the database with its parents, so a proof found from the
+// simplified clauses still runs back to the original ones. The clauses dropped for a pure literal or an
+// eliminated atom are not implied by what is left, so they go on a reconstruction stack together with the
+// literal that satisfies each of them, and Extend uses it to turn a model of the simplified clauses into a model
+// of the original ones.
+struct Preprocessor
+{
+public:
+  ClauseDatabase& db;
+
+  Preprocessor(ClauseDatabase& database);
+
+  // Simplifies the clauses ids and replaces them with the clauses to search instead. support holds a flag for
+  // each clause in ids and is replaced in step; a new clause is in the set of support if either parent is.
+  // Gives up on subsumption and elimination after about budget literal visits. Returns the id of the False
+  // clause if one is found, otherwise -1.
+  int Simplify(std::vector<int>& ids, std::vector<bool>& support, int budget, ProverStats& stats);
+
+  // Turns model, a value per atom (1 true, -1 false, 0 either), from a model of the simplified clauses into a
+  // model of the clauses Simplify was given
+  void Extend(std::vector<signed char>& model) const;
+
+private:
+  // A clause dropped without being implied by the rest, and a literal that makes it true
+  struct Removed
+  {
+    Literal witness;
+    int clause;
+  };
+
+  std::vector<Removed> stack;
+
+  // Per clause id, whether it is still in the set and whether it is in the set of support
+  std::vector<bool> active;
+  std::vector<bool> supports;
+
+  // Per literal, the clauses it occurs in, which may still list removed ones, and how many of them are active
+  std::vector<std::vector<int>> occurs;
+  std::vector<int> counts;
+
+  ClauseSet seen;
+
+  // Clauses still to be tried for subsumption and strengthening, and atoms whose occurrences dropped
+  std::vector<int> added;
+  std::vector<int> touched;
+
+  // Per literal, whether it is in the clause being tested as a subset
+  std::vector<bool> marks;
+
+  std::vector<Literal> resolvent;
+
+  // Puts clause id in the set, unless an equal clause already is. Returns false if it was a duplicate.
+  bool Add(int id, bool support);
+  void Remove(int id);
+
+  // Stores the resolvent of a and b, which must clash, and puts it in the set. Returns its id, or the id of
+  // the equal clause already in the set.
+  int AddResolvent(int a, int b);
+
+  // Drops the clauses of every pure literal among the touched atoms, and of the ones that become pure as a result
+  void RemovePure(ProverStats& stats);
+
+  // Uses clause id to drop the clauses it subsumes and strengthen the ones it can. Returns the id of the False
+  // clause if a strengthened clause is False, otherwise -1.
+  int Subsume(int id, int& budget, ProverStats& stats);
+
+  // Eliminates atom if that does not add clauses. Returns the id of the False clause if a resolvent is False,
+  // otherwise -1.
+  int Eliminate(int atom, int& budget, ProverStats& stats);
+};
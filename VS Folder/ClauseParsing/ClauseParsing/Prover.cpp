@@ -0,0 +1,18 @@
+// Prover.cpp : the interface shared by the proof engines
+//
+
+#include "stdafx.h"
+#include "Prover.h"
+#include "Cdcl.h"
+
+using namespace std;
+
+unique_ptr<Prover> MakeProver(const ProverOptions& options)
+{
+  if (options.engine == "resolution")
+    return unique_ptr<Prover>(new ResolutionProver(options));
+  if (options.engine == "cdcl")
+    return unique_ptr<Prover>(new CdclProver(options));
+
+  return unique_ptr<Prover>();
+}
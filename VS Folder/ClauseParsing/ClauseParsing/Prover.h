@@ -0,0 +1,40 @@
+// Prover.h : the interface shared by the proof engines
+//
+
+#pragma once
+
+#include "ClauseDatabase.h"
+#include "Saturation.h"
+
+// One way of deciding a clause set. Every engine works on the same ClauseDatabase and stores each clause it
+// derives there with its parents, so a refutation from any of them prints with PrintVector.
+struct Prover
+{
+public:
+  // What the engine's runs did, added up over every call to Prove
+  ProverStats stats;
+
+  // A model of the clauses from the last call to Prove, when it found them satisfiable and the engine keeps
+  // one: a value per atom, 1 true, -1 false or 0 either. Empty otherwise.
+  std::vector<signed char> model;
+
+  virtual ~Prover() {}
+
+  // Decides the clauses in db. Returns the id of the False clause if they are unsatisfiable, -1 if they are
+  // satisfiable, or UnknownResult if the engine gave up within its budget.
+  virtual int Prove(ClauseDatabase& db) = 0;
+};
+
+// The given-clause resolution engine, see Saturate
+struct ResolutionProver : public Prover
+{
+public:
+  ProverOptions options;
+
+  ResolutionProver(const ProverOptions& opts) : options(opts) {}
+
+  int Prove(ClauseDatabase& db) override { return Saturate(db, options, &stats); }
+};
+
+// Creates the engine named by options.engine, or returns NULL if there is no engine by that name
+std::unique_ptr<Prover> MakeProver(const ProverOptions& options);
@@ -0,0 +1,815 @@
+// Saturation.cpp : the given-clause resolution loop
+//
+
+#include "stdafx.h"
+#include "Saturation.h"
+#include "Trace.h"
+
+using namespace std;
+
+template <class Kernel, class Strategy>
+Saturation<Kernel, Strategy>::Saturation(ClauseDatabase& database, const ProverOptions& opts)
+  : db(database), options(opts), kernel(database), strategy(database, opts), units(database, seen), picks(0), inputs(0), incomplete(false),
+    decided(false), progress(opts.progress)
+{
+}
+
+template <class Kernel, class Strategy>
+int Saturation<Kernel, Strategy>::Start()
+{
+  int given = db.Size();
+  int firstQuery = 0;
+  if (options.queryClauses > 0 && !Strategy::Restricts)
+    firstQuery = max(0, given - options.queryClauses);
+
+  vector<bool> redundant(given, false);
+  int conflict = SimplifyBinaries(redundant);
+  if (conflict >= 0)
+    return conflict;
+
+  // The units of failed literals join the set of support, which is always safe
+  vector<int> ids;
+  vector<bool> support;
+  for (int x = 0; x < db.Size(); x++)
+  {
+    if (x < given ? redundant[x] : db.Length(x) != 1)
+      continue;
+    ids.push_back(x);
+    support.push_back(x >= firstQuery);
+  }
+
+  if (options.preprocess && !decided)
+  {
+    conflict = Preprocessor(db).Simplify(ids, support, SimplificationBudget(db), stats);
+    if (conflict >= 0)
+      return conflict;
+  }
+
+  // The rules go straight into the processed set, so they are never resolved against each other
+  inputs = db.Size();
+  for (int x = 0; x < ids.size(); x++)
+  {
+    conflict = Input(ids[x], support[x]);
+    if (conflict >= 0)
+      return conflict;
+  }
+
+  return PropagateUnits();
+}
+
+template <class Kernel, class Strategy>
+int Saturation<Kernel, Strategy>::SimplifyBinaries(vector<bool>& redundant)
+{
+  if (!options.binaryGraph)
+    return -1;
+
+  ImplicationGraph graph(db);
+  int conflict = graph.Simplify(SimplificationBudget(db), stats);
+  if (conflict >= 0)
+    return conflict;
+
+  redundant.swap(graph.redundant);
+
+  // With no longer clauses the graph has seen everything, and found no contradiction
+  decided = true;
+  for (int x = 0; x < redundant.size() && decided; x++)
+    decided = db.Length(x) <= 2;
+  return -1;
+}
+
+template <class Kernel, class Strategy>
+int Saturation<Kernel, Strategy>::Input(int id, bool support)
+{
+  if (db.Length(id) == 0)
+    return id;
+
+  // A tautology is true in every model and can never help to derive False
+  if (kernel.IsTautology(id))
+  {
+    stats.tautologies++;
+    return -1;
+  }
+
+  int existing = seen.Find(db, db.Begin(id), db.End(id));
+  if (existing >= 0 && db.Level(existing) <= db.Level(id))
+    return -1;
+  if (existing >= 0)
+    seen.Erase(db, existing);
+  seen.Insert(db, id);
+
+  if (support)
+    Enqueue(id);
+  else if (!ForwardSubsumed(db.Begin(id), db.End(id), db.Level(id)))
+    Activate(id);
+
+  return units.Attach(id);
+}
+
+template <class Kernel, class Strategy>
+int Saturation<Kernel, Strategy>::Run()
+{
+  if (options.threads > 1)
+    return RunParallel();
+
+  int conflict = Start();
+  if (conflict >= 0 || decided)
+    return conflict;
+
+  return Continue();
+}
+
+template <class Kernel, class Strategy>
+int Saturation<Kernel, Strategy>::Continue()
+{
+  // Inputs added since the last call may have left units to propagate
+  int conflict = PropagateUnits();
+  if (conflict >= 0)
+    return conflict;
+
+  vector<Literal> given;
+  vector<Literal> resolvent;
+
+  int id;
+  while (true)
+  {
+    if (OverBudget() && !Collect())
+      return UnknownResult;
+
+    if ((id = Select()) < 0)
+      break;
+
+    // A clause processed after this one was queued may subsume it by now
+    if (ForwardSubsumed(db.Begin(id), db.End(id), db.Level(id)))
+    {
+      stats.forwardSubsumed++;
+      Retire(id);
+      continue;
+    }
+
+    stats.givenClauses++;
+    stats.Sample(db);
+    if (progress.Due())
+      stats.WriteProgress(cerr, db);
+
+    // Copy the literals out, since adding resolvents can move the pool
+    given.assign(db.Begin(id), db.End(id));
+
+    for (int x = 0; x < given.size(); x++)
+    {
+      if (!strategy.Eligible(id, given[x]))
+        continue;
+
+      const vector<int>& partners = processed.Occurrences(Complement(given[x]));
+
+      for (int i = 0; i < partners.size(); i++)
+      {
+        if (IsRetired(partners[i]) || !strategy.Eligible(partners[i], Complement(given[x])))
+          continue;
+
+        // The partner clashes on given[x], so a failed resolution means a second clash and a tautology
+        stats.pairsTried++;
+        if (!kernel.Resolve(id, partners[i], resolvent))
+        {
+          stats.tautologies++;
+          continue;
+        }
+        stats.resolvents++;
+
+        int level = max(db.Level(id), db.Level(partners[i]));
+        if (Redundant(resolvent.data(), resolvent.data() + resolvent.size(), level, stats))
+          continue;
+
+        conflict = Keep(resolvent, id, partners[i]);
+        if (conflict >= 0)
+        {
+          // The given clause goes back in the queues, in case the caller pops the refutation and carries on
+          done[id] = false;
+          Enqueue(id);
+          return conflict;
+        }
+      }
+    }
+
+    Activate(id);
+
+    conflict = PropagateUnits();
+    if (conflict >= 0)
+      return conflict;
+  }
+
+  return incomplete ? UnknownResult : -1;
+}
+
+template <class Kernel, class Strategy>
+void Saturation<Kernel, Strategy>::Pop(int first)
+{
+  for (int x = first; x < db.Size(); x++)
+  {
+    if (!db.IsDead(x))
+      continue;
+
+    Retire(x);
+    seen.Erase(db, x);
+
+    // The dead clauses are the newest ones, so they mostly sit at the ends of the occurrence lists
+    for (const Literal* l = db.Begin(x); l != db.End(x); l++)
+    {
+      if (*l < processed.lists.size())
+      {
+        vector<int>& list = processed.lists[*l];
+        while (!list.empty() && IsRetired(list.back()))
+          list.pop_back();
+      }
+      if (*l < byFirstLiteral.lists.size())
+      {
+        vector<int>& list = byFirstLiteral.lists[*l];
+        while (!list.empty() && IsRetired(list.back()))
+          list.pop_back();
+      }
+    }
+  }
+
+  units.Pop();
+}
+
+template <class Kernel, class Strategy>
+int Saturation<Kernel, Strategy>::RunParallel()
+{
+  int conflict = Start();
+  if (conflict >= 0 || decided)
+    return conflict;
+
+  // Resolvents one worker found during a round, each with the ticket it drew
+  struct Output
+  {
+    vector<Literal> pool;
+    vector<ClauseHeader> headers;
+    vector<Literal> given;
+    vector<Literal> resolvent;
+    ProverStats stats;
+  };
+
+  int workers = options.threads;
+  vector<Output> outputs(workers);
+  vector<int> batchOrder;
+  WorkQueues queues(workers);
+  ConcurrentClauseSet pending;
+  atomic<int> nextTicket(0);
+  atomic<bool> foundFalse(false);
+
+  // During a round the database, the processed set and the retired flags are only read. New clauses go to the
+  // worker's own output and are committed by this thread once every worker has finished.
+  auto job = [&](int worker)
+  {
+    Output& out = outputs[worker];
+    int id;
+
+    while (!foundFalse && queues.Pop(worker, id))
+    {
+      out.given.assign(db.Begin(id), db.End(id));
+
+      for (int x = 0; x < out.given.size(); x++)
+      {
+        if (!strategy.Eligible(id, out.given[x]))
+          continue;
+
+        const vector<int>& partners = processed.Occurrences(Complement(out.given[x]));
+
+        for (int i = 0; i < partners.size(); i++)
+        {
+          // Two given clauses of the same round are resolved once, by the one that was picked later
+          int partner = partners[i];
+          if (IsRetired(partner) || (partner < batchOrder.size() && batchOrder[partner] >= batchOrder[id]))
+            continue;
+          if (!strategy.Eligible(partner, Complement(out.given[x])))
+            continue;
+
+          out.stats.pairsTried++;
+          if (!kernel.Resolve(id, partner, out.resolvent))
+          {
+            out.stats.tautologies++;
+            continue;
+          }
+          out.stats.resolvents++;
+
+          int level = max(db.Level(id), db.Level(partner));
+          if (Redundant(out.resolvent.data(), out.resolvent.data() + out.resolvent.size(), level, out.stats))
+            continue;
+
+          if (!pending.Insert(out.resolvent))
+          {
+            out.stats.duplicates++;
+            continue;
+          }
+
+          ClauseHeader h;
+          h.offset = (uint32_t)out.pool.size();
+          h.length = (uint32_t)out.resolvent.size();
+          h.id = nextTicket++;
+          h.parents[0] = id;
+          h.parents[1] = partner;
+          h.level = level;
+          out.headers.push_back(h);
+          out.pool.insert(out.pool.end(), out.resolvent.begin(), out.resolvent.end());
+
+          if (out.resolvent.empty())
+            foundFalse = true;
+        }
+      }
+    }
+  };
+
+  WorkerPool pool(workers, job);
+  size_t batchSize = workers * 8;
+  vector<int> batch;
+  vector<pair<int, int>> tickets;
+  vector<size_t> cursors(workers);
+  vector<Literal> lits;
+
+  while (true)
+  {
+    if (OverBudget())
+    {
+      if (!Collect())
+        return UnknownResult;
+      batchOrder.assign(db.Size(), -1);
+    }
+
+    // Pick the round's given clauses and move them into the processed set up front
+    batch.clear();
+    int id;
+    while (batch.size() < batchSize && (id = Select()) >= 0)
+    {
+      if (ForwardSubsumed(db.Begin(id), db.End(id), db.Level(id)))
+      {
+        stats.forwardSubsumed++;
+        Retire(id);
+        continue;
+      }
+
+      stats.givenClauses++;
+      Activate(id);
+      if (id >= batchOrder.size())
+        batchOrder.resize(db.Size(), -1);
+      batchOrder[id] = (int)batch.size();
+      queues.Push((int)batch.size() % workers, id);
+      batch.push_back(id);
+    }
+
+    if (batch.empty())
+      return incomplete ? UnknownResult : -1;
+
+    stats.Sample(db);
+    if (progress.Due())
+      stats.WriteProgress(cerr, db);
+
+    kernel.Sync();
+    strategy.Sync();
+    pool.RunRound();
+
+    for (int x = 0; x < batch.size(); x++)
+      batchOrder[batch[x]] = -1;
+    pending.Clear();
+
+    // Commit in ticket order. Each worker drew its tickets in increasing order, so one cursor per worker is
+    // enough to walk its output.
+    tickets.clear();
+    for (int w = 0; w < workers; w++)
+    {
+      cursors[w] = 0;
+      for (int x = 0; x < outputs[w].headers.size(); x++)
+        tickets.push_back(make_pair(outputs[w].headers[x].id, w));
+    }
+    sort(tickets.begin(), tickets.end());
+
+    for (int x = 0; x < tickets.size(); x++)
+    {
+      int w = tickets[x].second;
+      const ClauseHeader& h = outputs[w].headers[cursors[w]++];
+      const Literal* begin = outputs[w].pool.data() + h.offset;
+      lits.assign(begin, begin + h.length);
+
+      // Unit propagation during this commit may already have stored the same clause
+      if (Redundant(lits.data(), lits.data() + lits.size(), h.level, stats))
+        continue;
+
+      conflict = Keep(lits, h.parents[0], h.parents[1]);
+      if (conflict >= 0)
+        return conflict;
+    }
+
+    for (int w = 0; w < workers; w++)
+    {
+      outputs[w].pool.clear();
+      outputs[w].headers.clear();
+      stats.Add(outputs[w].stats);
+      outputs[w].stats = ProverStats();
+    }
+
+    conflict = PropagateUnits();
+    if (conflict >= 0)
+      return conflict;
+  }
+}
+
+template <class Kernel, class Strategy>
+int Saturation<Kernel, Strategy>::Keep(const vector<Literal>& lits, int parent1, int parent2)
+{
+  // A copy at a higher level can be left where it is; this one subsumes it once it is processed
+  int existing = seen.Find(db, lits);
+  if (existing >= 0)
+    seen.Erase(db, existing);
+
+  int result = db.Add(lits, parent1, parent2);
+  seen.Insert(db, result);
+
+  if (lits.size() == 0)
+    return result;
+
+  Enqueue(result);
+  return units.Attach(result);
+}
+
+template <class Kernel, class Strategy>
+void Saturation<Kernel, Strategy>::Enqueue(int id)
+{
+  if (id >= done.size())
+    done.resize(id + 1, false);
+
+  byWeight.push(WeightedClause(db.Length(id), id));
+  byAge.push(id);
+}
+
+template <class Kernel, class Strategy>
+void Saturation<Kernel, Strategy>::Activate(int id)
+{
+  if (id >= retired.size())
+    retired.resize(id + 1, false);
+
+  BackwardSubsume(id);
+
+  processed.Insert(db, id);
+  byFirstLiteral.Add(*db.Begin(id), id);
+}
+
+template <class Kernel, class Strategy>
+void Saturation<Kernel, Strategy>::Retire(int id)
+{
+  if (id >= retired.size())
+    retired.resize(id + 1, false);
+  retired[id] = true;
+}
+
+template <class Kernel, class Strategy>
+int Saturation<Kernel, Strategy>::PropagateUnits()
+{
+  int conflict = units.Propagate();
+
+  for (int x = 0; x < units.derived.size(); x++)
+    Enqueue(units.derived[x]);
+  units.derived.clear();
+
+  return conflict;
+}
+
+template <class Kernel, class Strategy>
+bool Saturation<Kernel, Strategy>::Redundant(const Literal* begin, const Literal* end, int level, ProverStats& counts) const
+{
+  int existing = seen.Find(db, begin, end);
+  if (existing >= 0 && db.Level(existing) <= level)
+  {
+    counts.duplicates++;
+    return true;
+  }
+
+  if (!ForwardSubsumed(begin, end, level))
+    return false;
+
+  counts.forwardSubsumed++;
+  return true;
+}
+
+template <class Kernel, class Strategy>
+bool Saturation<Kernel, Strategy>::ForwardSubsumed(const Literal* begin, const Literal* end, int level) const
+{
+  uint64_t sig = ClauseDatabase::Signature(begin, end);
+
+  // A subset of the clause has its smallest literal somewhere in the clause, so every candidate is listed under
+  // one of the clause's literals
+  for (const Literal* l = begin; l != end; l++)
+  {
+    const vector<int>& candidates = byFirstLiteral.Occurrences(*l);
+
+    for (int x = 0; x < candidates.size(); x++)
+    {
+      int c = candidates[x];
+      if (retired[c] || db.Level(c) > level || (db.signatures[c] & ~sig) != 0)
+        continue;
+
+      if (ClauseDatabase::IsSubset(db.Begin(c), db.End(c), l, end))
+        return true;
+    }
+  }
+  return false;
+}
+
+template <class Kernel, class Strategy>
+void Saturation<Kernel, Strategy>::BackwardSubsume(int id)
+{
+  // Every clause that id subsumes contains all of its literals, so the shortest of their lists is enough
+  const vector<int>* candidates = NULL;
+  for (const Literal* l = db.Begin(id); l != db.End(id); l++)
+  {
+    const vector<int>& list = processed.Occurrences(*l);
+    if (candidates == NULL || list.size() < candidates->size())
+      candidates = &list;
+  }
+
+  uint64_t sig = db.signatures[id];
+  for (int x = 0; x < candidates->size(); x++)
+  {
+    int c = (*candidates)[x];
+    if (retired[c] || db.Level(c) < db.Level(id) || (sig & ~db.signatures[c]) != 0)
+      continue;
+
+    if (kernel.Subsumes(id, c))
+    {
+      stats.backwardSubsumed++;
+      retired[c] = true;
+    }
+  }
+}
+
+template <class Kernel, class Strategy>
+int Saturation<Kernel, Strategy>::Select()
+{
+  // Every unprocessed clause sits in both queues, so once either one is empty nothing is left to pick
+  while (!byWeight.empty() && !byAge.empty())
+  {
+    // Every (weightRatio + 1)-th pick goes to the oldest clause, so long clauses are not starved forever
+    bool byAgeTurn = options.weightRatio <= 0 || picks % (options.weightRatio + 1) == options.weightRatio;
+
+    int id;
+    if (byAgeTurn)
+    {
+      id = byAge.front();
+      byAge.pop();
+    }
+    else
+    {
+      id = byWeight.top().second;
+      byWeight.pop();
+    }
+
+    // The copy left behind in the other queue is skipped when it comes up, and so is a clause killed by a pop
+    if (done[id] || IsRetired(id))
+      continue;
+
+    done[id] = true;
+    picks++;
+    return id;
+  }
+
+  return -1;
+}
+
+template <class Kernel, class Strategy>
+bool Saturation<Kernel, Strategy>::OverBudget() const
+{
+  if (options.maxClauses > 0 && db.Size() > options.maxClauses)
+    return true;
+  return options.maxMemoryMB > 0 && Footprint() > ((size_t)options.maxMemoryMB << 20);
+}
+
+template <class Kernel, class Strategy>
+size_t Saturation<Kernel, Strategy>::Footprint() const
+{
+  // Besides its header and signature, each clause takes a few per-id flags, two watches and a dedup slot, and
+  // each literal appears in the pool and in up to two occurrence lists
+  size_t perClause = sizeof(ClauseHeader) + sizeof(uint64_t) + 2 * sizeof(Literal) + 2 * sizeof(int) + 32;
+  return db.Size() * perClause + db.pool.size() * 3 * sizeof(Literal);
+}
+
+template <class Kernel, class Strategy>
+bool Saturation<Kernel, Strategy>::Collect()
+{
+  stats.collections++;
+  stats.Sample(db);
+
+  int size = db.Size();
+  vector<bool> keep(size, false);
+  vector<int> queued;
+
+  // Inputs, processed clauses and the unit propagator's reasons have to stay
+  for (int x = 0; x < inputs && x < size; x++)
+    keep[x] = true;
+  for (int l = 0; l < byFirstLiteral.lists.size(); l++)
+  {
+    for (int x = 0; x < byFirstLiteral.lists[l].size(); x++)
+    {
+      int id = byFirstLiteral.lists[l][x];
+      if (!IsRetired(id))
+        keep[id] = true;
+    }
+  }
+  units.Roots(keep);
+
+  int roots = 0;
+  for (int x = 0; x < size; x++)
+  {
+    if (keep[x])
+      roots++;
+    else if (!IsRetired(x) && !(x < done.size() && done[x]))
+      queued.push_back(x);
+  }
+
+  // Keep the short, young unprocessed clauses, which are the ones the weight and age queues pick first
+  int target = size / 2;
+  if (options.maxClauses > 0)
+    target = min(target, options.maxClauses / 2);
+  if (options.maxMemoryMB > 0)
+    target = min(target, (int)(size * (((size_t)options.maxMemoryMB << 19) / (double)Footprint())));
+
+  sort(queued.begin(), queued.end(), [this](int a, int b)
+  {
+    return db.Length(a) != db.Length(b) ? db.Length(a) < db.Length(b) : a > b;
+  });
+
+  int room = max(0, target - roots);
+  for (int x = 0; x < queued.size() && x < room; x++)
+    keep[queued[x]] = true;
+  if (room < queued.size())
+    incomplete = true;
+
+  // Parents always have smaller ids than their children, so one pass down the ids keeps every ancestor
+  for (int x = size - 1; x >= 0; x--)
+  {
+    if (!keep[x] || db.headers[x].parents[0] < 0)
+      continue;
+    keep[db.headers[x].parents[0]] = true;
+    keep[db.headers[x].parents[1]] = true;
+  }
+
+  vector<int> newIds(size, -1);
+  vector<bool> inSeen(size, false);
+  int kept = 0;
+  for (int x = 0; x < size; x++)
+  {
+    if (!keep[x])
+      continue;
+    newIds[x] = kept++;
+    inSeen[x] = seen.Find(db, db.Begin(x), db.End(x)) == x;
+  }
+
+  if (kept == size)
+    return !OverBudget();
+
+  // Move the kept clauses into fresh arrays, so the memory of the evicted ones is really given back
+  ClauseDatabase compact;
+  compact.pool.reserve(db.pool.size());
+  compact.headers.reserve(kept);
+  compact.signatures.reserve(kept);
+  for (int x = 0; x < size; x++)
+  {
+    if (!keep[x])
+      continue;
+
+    ClauseHeader h = db.headers[x];
+    h.offset = (uint32_t)compact.pool.size();
+    h.id = newIds[x];
+    if (h.parents[0] >= 0)
+    {
+      h.parents[0] = newIds[h.parents[0]];
+      h.parents[1] = newIds[h.parents[1]];
+    }
+
+    compact.pool.insert(compact.pool.end(), db.Begin(x), db.End(x));
+    compact.headers.push_back(h);
+    compact.signatures.push_back(db.signatures[x]);
+  }
+  compact.pool.shrink_to_fit();
+
+  // A scope now starts at the first kept clause at or after its old start
+  for (int x = 0; x < db.scopeStarts.size(); x++)
+  {
+    int start = db.scopeStarts[x];
+    while (start < size && newIds[start] < 0)
+      start++;
+    db.scopeStarts[x] = start < size ? newIds[start] : kept;
+  }
+
+  if (db.trace != NULL)
+    db.trace->Remap(newIds);
+
+  db.pool.swap(compact.pool);
+  db.headers.swap(compact.headers);
+  db.signatures.swap(compact.signatures);
+
+  // Renumber everything that refers to clauses by id
+  seen = ClauseSet();
+  vector<bool> newRetired(kept, false);
+  vector<bool> newDone(kept, false);
+  for (int x = 0; x < size; x++)
+  {
+    if (!keep[x])
+      continue;
+    if (inSeen[x])
+      seen.Insert(db, newIds[x]);
+    newRetired[newIds[x]] = IsRetired(x);
+    newDone[newIds[x]] = x < done.size() && done[x];
+  }
+  retired.swap(newRetired);
+  done.swap(newDone);
+
+  OccurrenceIndex* indexes[2] = { &processed, &byFirstLiteral };
+  for (int i = 0; i < 2; i++)
+  {
+    for (int l = 0; l < indexes[i]->lists.size(); l++)
+    {
+      vector<int>& list = indexes[i]->lists[l];
+      size_t count = 0;
+      for (int x = 0; x < list.size(); x++)
+      {
+        if (newIds[list[x]] >= 0)
+          list[count++] = newIds[list[x]];
+      }
+      list.resize(count);
+    }
+  }
+
+  byWeight = decltype(byWeight)();
+  byAge = queue<int>();
+  for (int x = 0; x < kept; x++)
+  {
+    if (!done[x] && !retired[x] && x >= inputs)
+      Enqueue(x);
+  }
+
+  kernel.Reset();
+  strategy.Reset();
+  units.Remap(newIds);
+
+  return !OverBudget();
+}
+
+template struct Saturation<SortedKernel>;
+template struct Saturation<SortedKernel, OrderedResolution>;
+template struct Saturation<SortedKernel, NegativeSelection>;
+template struct Saturation<BitsetKernel<64>>;
+template struct Saturation<BitsetKernel<64>, OrderedResolution>;
+template struct Saturation<BitsetKernel<64>, NegativeSelection>;
+template struct Saturation<BitsetKernel<128>>;
+template struct Saturation<BitsetKernel<128>, OrderedResolution>;
+template struct Saturation<BitsetKernel<128>, NegativeSelection>;
+template struct Saturation<BitsetKernel<256>>;
+template struct Saturation<BitsetKernel<256>, OrderedResolution>;
+template struct Saturation<BitsetKernel<256>, NegativeSelection>;
+template struct Saturation<BitsetKernel<512>>;
+template struct Saturation<BitsetKernel<512>, OrderedResolution>;
+template struct Saturation<BitsetKernel<512>, NegativeSelection>;
+
+// Runs one saturation and hands its counters to stats
+template <class Kernel, class Strategy>
+int Saturate(ClauseDatabase& db, const ProverOptions& options, ProverStats* stats)
+{
+  Saturation<Kernel, Strategy> saturation(db, options);
+  int result = saturation.Run();
+
+  saturation.stats.Sample(db);
+  if (stats != NULL)
+    stats->Add(saturation.stats);
+  return result;
+}
+
+// Picks the strategy for a kernel
+template <class Kernel>
+int Saturate(ClauseDatabase& db, const ProverOptions& options, ProverStats* stats)
+{
+  if (options.strategy == "ordered")
+    return Saturate<Kernel, OrderedResolution>(db, options, stats);
+  if (options.strategy == "negative")
+    return Saturate<Kernel, NegativeSelection>(db, options, stats);
+
+  return Saturate<Kernel, UnrestrictedResolution>(db, options, stats);
+}
+
+int Saturate(ClauseDatabase& db, const ProverOptions& options, ProverStats* stats)
+{
+  int atoms = (int)db.atoms.names.size();
+
+  if (options.bitsets && atoms <= 64)
+    return Saturate<BitsetKernel<64>>(db, options, stats);
+  if (options.bitsets && atoms <= 128)
+    return Saturate<BitsetKernel<128>>(db, options, stats);
+  if (options.bitsets && atoms <= 256)
+    return Saturate<BitsetKernel<256>>(db, options, stats);
+  if (options.bitsets && atoms <= 512)
+    return Saturate<BitsetKernel<512>>(db, options, stats);
+
+  return Saturate<SortedKernel>(db, options, stats);
+}
+
+int SimplificationBudget(const ClauseDatabase& db)
+{
+  return (int)min<uint64_t>(8 * (uint64_t)db.pool.size() + 1000, INT_MAX);
+}
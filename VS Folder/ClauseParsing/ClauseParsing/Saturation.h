@@ -0,0 +1,205 @@
+// Saturation.h : the given-clause resolution loop
+//
+
+#pragma once
+
+#include "ClauseDatabase.h"
+#include "UnitPropagator.h"
+#include "BitClause.h"
+#include "Parallel.h"
+#include "Stats.h"
+#include "Strategy.h"
+#include "ImplicationGraph.h"
+#include "Preprocessor.h"
+
+// Settings for a proof run, filled in from the command line by main
+struct ProverOptions
+{
+public:
+  // How many given clauses are picked by weight for every one picked by age. 0 picks purely by age.
+  int weightRatio = 4;
+
+  // How many of the last input clauses are the negated query. They form the initial set of support, and every
+  // other input clause is only ever resolved against them and their descendants. 0 turns set of support off.
+  int queryClauses = 1;
+
+  // Whether to resolve on bitset copies of the clauses when there are at most 512 atoms
+  bool bitsets = true;
+
+  // Whether to run the input's binary and unit clauses through an ImplicationGraph before saturating
+  bool binaryGraph = true;
+
+  // Whether to simplify the input with a Preprocessor before the search
+  bool preprocess = true;
+
+  // How many threads saturate at once. 1 runs the sequential loop.
+  int threads = 1;
+
+  // The engine MakeProver creates: "resolution" or "cdcl"
+  std::string engine = "resolution";
+
+  // Budgets for the resolution engine, 0 for no limit: the number of clauses in the database and a rough
+  // estimate of the memory the run holds, in megabytes. See Saturation::Collect.
+  int maxClauses = 0;
+  int maxMemoryMB = 0;
+
+  // Seconds between progress lines on cerr during the search, 0 for none
+  int progress = 0;
+
+  // Which literals the resolution engine resolves on: "all", "ordered" or "negative", see Strategy.h. The
+  // ordered strategies rank the atoms by order, "input", "frequency" or "file", and with "file" by the atom
+  // names in atomOrder.
+  std::string strategy = "all";
+  std::string order = "frequency";
+  std::vector<std::string> atomOrder;
+};
+
+// Returned by a prover in place of a clause id when a budget stopped it before it could decide the input
+const int UnknownResult = -2;
+
+// The work budget for simplifying the input before a search: a few visits per input literal, which keeps it
+// linear in the input, computed wide and clamped so that a huge input cannot overflow it
+int SimplificationBudget(const ClauseDatabase& db);
+
+// Otter-style given-clause saturation. Processed clauses have been resolved against each other and are indexed
+// by literal; unprocessed clauses wait in two queues, one ordered by weight (literal count) and one by age.
+// Each round the next given clause is taken from one of the queues, resolved against every processed clause it
+// clashes with, and then moved into the processed set.
+//
+// Subsumption keeps the processed set small: a clause that a processed clause subsumes is never stored or
+// processed (forward), and a new given clause retires every processed clause it subsumes (backward).
+//
+// Before the first given clause, the binary and unit input clauses go through an ImplicationGraph. It refutes an
+// unsatisfiable 2-SAT core on its own, answers an input of nothing but binary and unit clauses outright, adds
+// the units of failed literals as inputs, and leaves out the binary clauses the others imply. What is left then
+// goes through a Preprocessor, which removes pure literals, subsumed clauses and eliminable atoms.
+//
+// Every stored clause is also handed to a UnitPropagator, which runs to fixpoint before the first given clause
+// and after each one. The units it derives join the unprocessed queues like any other resolvent.
+//
+// With more than one thread, RunParallel takes the given clauses in batches instead. The whole batch is moved
+// into the processed set first, then worker threads resolve its clauses against the processed set while nothing
+// else changes, and their resolvents are stored in one go afterwards. Which clauses get derived in a round can
+// depend on timing, but every stored clause is still an ordinary resolvent with the usual parents.
+//
+// With a clause or memory budget, the database is collected whenever it goes over: the longest and oldest
+// unprocessed clauses are evicted and every other clause is renumbered into fresh, compact storage. A clause
+// that is an ancestor of a kept clause is always kept, so PrintVector can still print any proof. Once an
+// unprocessed clause has been evicted the search is no longer complete, so running dry gives UnknownResult
+// rather than -1, and so does a collection that cannot get back under the budget.
+//
+// Kernel does the pairwise work of the inner loop (clash test, resolvent, subset test) and is either
+// SortedKernel or one of the BitsetKernel widths. Strategy says which literals may be resolved on and is one of
+// the strategies in Strategy.h. Saturate picks both.
+template <class Kernel, class Strategy = UnrestrictedResolution>
+struct Saturation
+{
+public:
+  ClauseDatabase& db;
+  ProverOptions options;
+  Kernel kernel;
+  Strategy strategy;
+
+  ClauseSet seen;
+  OccurrenceIndex processed;
+
+  // Processed clauses listed under their smallest literal only, for forward subsumption
+  OccurrenceIndex byFirstLiteral;
+
+  // Clauses removed by subsumption. They stay in the database for proofs but take no further part.
+  std::vector<bool> retired;
+
+  UnitPropagator units;
+
+  ProverStats stats;
+
+  Saturation(ClauseDatabase& database, const ProverOptions& opts);
+
+  // Saturates the clauses in the database. Returns the id of the False clause, -1 if the set saturated without
+  // deriving it, or UnknownResult if the budget ran out.
+  int Run();
+
+  // Takes in one more input clause: into the set of support if support is set, otherwise straight into the
+  // processed set. Returns the id of the False clause if unit propagation refutes it, otherwise -1.
+  int Input(int id, bool support);
+
+  // Runs the given-clause loop until False is derived or the queues run dry. Returns the id of the False clause,
+  // -1 or UnknownResult as Run does. Calling it again after adding inputs carries on from where it stopped.
+  int Continue();
+
+  // Forgets every clause killed by the ClauseDatabase::Pop that returned first. Clauses at lower levels keep
+  // their place in the processed set and the queues.
+  void Pop(int first);
+
+private:
+  typedef std::pair<int, int> WeightedClause;
+
+  std::priority_queue<WeightedClause, std::vector<WeightedClause>, std::greater<WeightedClause>> byWeight;
+  std::queue<int> byAge;
+  std::vector<bool> done;
+  int picks;
+
+  // The number of input clauses, which are never evicted, and whether an unprocessed clause has been
+  int inputs;
+  bool incomplete;
+
+  // Whether the implication graph already decided the input
+  bool decided;
+
+  ProgressClock progress;
+
+  // Sets up the input clauses and propagates their units. Returns the id of the False clause, or -1.
+  int Start();
+
+  // Runs the implication graph over the input. Returns the id of the False clause, or -1 with the clauses to
+  // leave out marked in redundant and the failed-literal units added to the database.
+  int SimplifyBinaries(std::vector<bool>& redundant);
+
+  // The batched, multi-threaded version of Run
+  int RunParallel();
+
+  // Stores a new resolvent of parent1 and parent2 and queues it. Returns the id of the False clause if it is
+  // False or unit propagation refutes it, otherwise -1.
+  int Keep(const std::vector<Literal>& lits, int parent1, int parent2);
+
+  // Queues clause id as unprocessed
+  void Enqueue(int id);
+
+  // Moves clause id into the processed set
+  void Activate(int id);
+
+  // Runs unit propagation to fixpoint and queues the units it derived. Returns the id of the False clause on
+  // a conflict, otherwise -1.
+  int PropagateUnits();
+
+  // Finds if a clause at level or below already makes the sorted literals begin .. end unnecessary, as an equal
+  // clause or by subsuming them, and counts which of the two it was in counts
+  bool Redundant(const Literal* begin, const Literal* end, int level, ProverStats& counts) const;
+
+  // Finds if some processed clause at level or below is a subset of the sorted literals begin .. end. A clause
+  // from a deeper scope is not allowed to subsume, since it may be popped while the subsumed clause stays.
+  bool ForwardSubsumed(const Literal* begin, const Literal* end, int level) const;
+
+  // Retires every processed clause that clause id subsumes and that is at the same level or deeper
+  void BackwardSubsume(int id);
+
+  void Retire(int id);
+  bool IsRetired(int id) const { return id < retired.size() && retired[id]; }
+
+  // Takes the next given clause off the queues, or returns -1 when both are empty
+  int Select();
+
+  bool OverBudget() const;
+
+  // Rough bytes held for the clauses: the database arrays, the indexes and the propagator's watches
+  size_t Footprint() const;
+
+  // Evicts clauses until the database is at half its budget and renumbers the rest. Returns false if the clauses
+  // that must be kept already fill the budget.
+  bool Collect();
+};
+
+// Saturates the clauses in db with the fastest kernel for its atom count: a bitset kernel of the smallest width
+// that fits, or the sorted-array kernel beyond 512 atoms, and the strategy named by options.strategy. Returns the id of the False clause, -1 or UnknownResult.
+// The run's counters are added to stats if it is given.
+int Saturate(ClauseDatabase& db, const ProverOptions& options, ProverStats* stats = NULL);
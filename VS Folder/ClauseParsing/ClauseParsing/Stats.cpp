@@ -0,0 +1,92 @@
+// Stats.cpp : counters and phase timers for proof runs
+//
+
+#include "stdafx.h"
+#include "Stats.h"
+
+using namespace std;
+
+void ProverStats::Sample(const ClauseDatabase& db)
+{
+  peakClauses = max(peakClauses, db.Size());
+  peakBytes = max(peakBytes, db.Bytes());
+}
+
+void ProverStats::Add(const ProverStats& other)
+{
+  givenClauses += other.givenClauses;
+  pairsTried += other.pairsTried;
+  resolvents += other.resolvents;
+  tautologies += other.tautologies;
+  duplicates += other.duplicates;
+  forwardSubsumed += other.forwardSubsumed;
+  backwardSubsumed += other.backwardSubsumed;
+  collections += other.collections;
+  equivalentLiterals += other.equivalentLiterals;
+  failedLiterals += other.failedLiterals;
+  reducedBinaries += other.reducedBinaries;
+  pureLiterals += other.pureLiterals;
+  subsumedInputs += other.subsumedInputs;
+  strengthenedClauses += other.strengthenedClauses;
+  eliminatedAtoms += other.eliminatedAtoms;
+  conflicts += other.conflicts;
+  decisions += other.decisions;
+  restarts += other.restarts;
+  peakClauses = max(peakClauses, other.peakClauses);
+  peakBytes = max(peakBytes, other.peakBytes);
+
+  for (int x = 0; x < other.phases.size(); x++)
+    AddPhase(other.phases[x].first, other.phases[x].second);
+}
+
+void ProverStats::AddPhase(const string& name, double seconds)
+{
+  for (int x = 0; x < phases.size(); x++)
+  {
+    if (phases[x].first == name)
+    {
+      phases[x].second += seconds;
+      return;
+    }
+  }
+  phases.push_back(make_pair(name, seconds));
+}
+
+void ProverStats::WriteJson(ostream& os) const
+{
+  os << "{\n";
+  os << "  \"given_clauses\": " << givenClauses << ",\n";
+  os << "  \"pairs_tried\": " << pairsTried << ",\n";
+  os << "  \"resolvents\": " << resolvents << ",\n";
+  os << "  \"tautologies\": " << tautologies << ",\n";
+  os << "  \"duplicates\": " << duplicates << ",\n";
+  os << "  \"forward_subsumed\": " << forwardSubsumed << ",\n";
+  os << "  \"backward_subsumed\": " << backwardSubsumed << ",\n";
+  os << "  \"collections\": " << collections << ",\n";
+  os << "  \"equivalent_literals\": " << equivalentLiterals << ",\n";
+  os << "  \"failed_literals\": " << failedLiterals << ",\n";
+  os << "  \"reduced_binaries\": " << reducedBinaries << ",\n";
+  os << "  \"pure_literals\": " << pureLiterals << ",\n";
+  os << "  \"subsumed_inputs\": " << subsumedInputs << ",\n";
+  os << "  \"strengthened_clauses\": " << strengthenedClauses << ",\n";
+  os << "  \"eliminated_atoms\": " << eliminatedAtoms << ",\n";
+  os << "  \"conflicts\": " << conflicts << ",\n";
+  os << "  \"decisions\": " << decisions << ",\n";
+  os << "  \"restarts\": " << restarts << ",\n";
+  os << "  \"peak_clauses\": " << peakClauses << ",\n";
+  os << "  \"peak_bytes\": " << peakBytes << ",\n";
+
+  // Phase names are identifiers from the code, so they need no escaping
+  os << "  \"seconds\": {";
+  for (int x = 0; x < phases.size(); x++)
+    os << (x == 0 ? "" : ",") << "\n    \"" << phases[x].first << "\": " << phases[x].second;
+  os << (phases.empty() ? "}\n" : "\n  }\n");
+  os << "}\n";
+}
+
+void ProverStats::WriteProgress(ostream& os, const ClauseDatabase& db) const
+{
+  os << "c progress: clauses " << db.Size() << ", given " << givenClauses << ", pairs " << pairsTried
+    << ", resolvents " << resolvents << ", duplicates " << duplicates << ", subsumed "
+    << forwardSubsumed + backwardSubsumed << ", conflicts " << conflicts << endl;
+}
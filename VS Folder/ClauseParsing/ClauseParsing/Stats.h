@@ -0,0 +1,96 @@
+// Stats.h : counters and phase timers for proof runs
+//
+
+#pragma once
+
+#include "ClauseDatabase.h"
+
+// What a proof run did. The counters are plain integers bumped next to work that costs far more, so they are
+// always on. Threads that work in parallel count into their own copy, which is added in afterwards.
+struct ProverStats
+{
+public:
+  // Resolution: pairs handed to the kernel, and what came of them
+  uint64_t givenClauses = 0;
+  uint64_t pairsTried = 0;
+  uint64_t resolvents = 0;
+  uint64_t tautologies = 0;
+  uint64_t duplicates = 0;
+  uint64_t forwardSubsumed = 0;
+  uint64_t backwardSubsumed = 0;
+  uint64_t collections = 0;
+
+  // The implication graph of the binary clauses, see ImplicationGraph
+  uint64_t equivalentLiterals = 0;
+  uint64_t failedLiterals = 0;
+  uint64_t reducedBinaries = 0;
+
+  // Preprocessing of the input, see Preprocessor
+  uint64_t pureLiterals = 0;
+  uint64_t subsumedInputs = 0;
+  uint64_t strengthenedClauses = 0;
+  uint64_t eliminatedAtoms = 0;
+
+  // CDCL
+  uint64_t conflicts = 0;
+  uint64_t decisions = 0;
+  uint64_t restarts = 0;
+
+  // The most clauses, and the most bytes for them, the database held at once
+  int peakClauses = 0;
+  size_t peakBytes = 0;
+
+  // Seconds spent in each phase, in the order the phases first ran
+  std::vector<std::pair<std::string, double>> phases;
+
+  // Records the database's size if it is a new peak
+  void Sample(const ClauseDatabase& db);
+
+  // Adds the counters and phases of other to these, and takes the larger peaks
+  void Add(const ProverStats& other);
+
+  void AddPhase(const std::string& name, double seconds);
+
+  // Writes every counter, the peaks and the phase times as one JSON object
+  void WriteJson(std::ostream& os) const;
+
+  // Writes a one-line summary of the search so far, for progress output
+  void WriteProgress(std::ostream& os, const ClauseDatabase& db) const;
+};
+
+// Adds the time between its construction and its destruction to a phase of stats, on the monotonic clock
+struct PhaseTimer
+{
+public:
+  PhaseTimer(ProverStats& s, const char* phase) : stats(s), name(phase), start(std::chrono::steady_clock::now()) {}
+  ~PhaseTimer() { stats.AddPhase(name, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count()); }
+
+private:
+  ProverStats& stats;
+  const char* name;
+  std::chrono::steady_clock::time_point start;
+};
+
+// Tells a long loop when to print its next progress line. With an interval of 0 it is never due.
+struct ProgressClock
+{
+public:
+  ProgressClock(int seconds) : interval(seconds), next(std::chrono::steady_clock::now() + std::chrono::seconds(seconds)) {}
+
+  bool Due()
+  {
+    if (interval <= 0)
+      return false;
+
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    if (now < next)
+      return false;
+
+    next = now + std::chrono::seconds(interval);
+    return true;
+  }
+
+private:
+  int interval;
+  std::chrono::steady_clock::time_point next;
+};
@@ -0,0 +1,59 @@
+// Strategy.cpp : restrictions on which literals the given-clause loop resolves on
+//
+
+#include "stdafx.h"
+#include "Strategy.h"
+#include "Saturation.h"
+
+using namespace std;
+
+bool IsStrategy(const string& name)
+{
+  return name == "all" || name == "ordered" || name == "negative";
+}
+
+vector<int> AtomRanks(const ClauseDatabase& db, const ProverOptions& options)
+{
+  int atoms = (int)db.atoms.names.size();
+
+  // Atoms listed from highest rank to lowest
+  vector<int> order;
+  vector<bool> listed(atoms, false);
+
+  if (options.order == "file")
+  {
+    for (int x = 0; x < options.atomOrder.size(); x++)
+    {
+      auto atom = db.atoms.ids.find(options.atomOrder[x]);
+      if (atom == db.atoms.ids.end() || listed[atom->second])
+        continue;
+      listed[atom->second] = true;
+      order.push_back(atom->second);
+    }
+  }
+
+  size_t first = order.size();
+  for (int x = 0; x < atoms; x++)
+  {
+    if (!listed[x])
+      order.push_back(x);
+  }
+
+  if (options.order == "frequency")
+  {
+    vector<int> counts(atoms, 0);
+    for (int x = 0; x < db.Size(); x++)
+    {
+      for (const Literal* l = db.Begin(x); l != db.End(x); l++)
+        counts[AtomOf(*l)]++;
+    }
+
+    // Ties stay in input order
+    stable_sort(order.begin() + first, order.end(), [&counts](int a, int b) { return counts[a] < counts[b]; });
+  }
+
+  vector<int> ranks(atoms);
+  for (int x = 0; x < atoms; x++)
+    ranks[order[x]] = atoms - x;
+  return ranks;
+}
@@ -0,0 +1,100 @@
+// Strategy.h : restrictions on which literals the given-clause loop resolves on
+//
+
+#pragma once
+
+#include "ClauseDatabase.h"
+
+struct ProverOptions;
+
+// Ranks every atom of db for the ordered strategies; the atom with the highest rank is resolved on first.
+// options.order picks the ranking: "input" ranks the atoms read first highest, "frequency" ranks the atoms with
+// the fewest occurrences in the input clauses highest, and "file" ranks the atoms named in options.atomOrder
+// highest, in the order given, with the rest below them in input order.
+std::vector<int> AtomRanks(const ClauseDatabase& db, const ProverOptions& options);
+
+// Finds if name is one of the strategies Saturate knows: "all", "ordered" or "negative"
+bool IsStrategy(const std::string& name);
+
+// A strategy tells Saturation which literals of a clause it may resolve on. It is a template parameter, so the
+// check is inlined into the inner loop and costs nothing at all for UnrestrictedResolution. Each strategy has:
+//   Restricts      whether it ever says no. Set of support is off under a restricting strategy, since the two
+//                  together are not complete.
+//   Eligible(id, l) whether the loop may resolve clause id on its literal l
+//   Sync(), Reset() as for the kernels in BitClause.h
+
+// Resolves on every literal, which is plain binary resolution
+struct UnrestrictedResolution
+{
+public:
+  static const bool Restricts = false;
+
+  UnrestrictedResolution(const ClauseDatabase&, const ProverOptions&) {}
+
+  bool Eligible(int, Literal) { return true; }
+
+  void Sync() {}
+  void Reset() {}
+};
+
+// Resolves each clause on one literal only. With NegativeFirst false that is the literal of its highest ranked
+// atom, which is ordered resolution. With NegativeFirst true a clause that has negative literals is resolved on
+// the highest ranked of those instead, and only an all-positive clause falls back to the ordering, which is
+// ordered resolution with negative selection. Both are complete, and each derives a resolvent in one way only
+// where plain resolution finds it once for every order its atoms can be resolved away in.
+template <bool NegativeFirst>
+struct LiteralSelection
+{
+public:
+  static const bool Restricts = true;
+
+  const ClauseDatabase& db;
+  std::vector<int> ranks;
+
+  // The literal picked for each clause so far
+  std::vector<Literal> selected;
+
+  LiteralSelection(const ClauseDatabase& database, const ProverOptions& options)
+    : db(database), ranks(AtomRanks(database, options)) {}
+
+  bool Eligible(int id, Literal l)
+  {
+    Sync();
+    return selected[id] == l;
+  }
+
+  // Picks the literal of every clause added since the last call. Eligible calls it itself; it only needs calling
+  // directly before several threads share the strategy, after which they only read it.
+  void Sync()
+  {
+    for (int x = (int)selected.size(); x < db.Size(); x++)
+      selected.push_back(Select(x));
+  }
+
+  // Forgets the picks, for when the database has renumbered its clauses
+  void Reset() { selected.clear(); }
+
+private:
+  Literal Select(int id) const
+  {
+    // False is never resolved, so what it gets does not matter
+    if (db.Length(id) == 0)
+      return 0;
+
+    Literal best = *db.Begin(id);
+    for (const Literal* l = db.Begin(id) + 1; l != db.End(id); l++)
+    {
+      if (NegativeFirst && IsNegated(*l) != IsNegated(best))
+      {
+        if (IsNegated(*l))
+          best = *l;
+      }
+      else if (ranks[AtomOf(*l)] > ranks[AtomOf(best)])
+        best = *l;
+    }
+    return best;
+  }
+};
+
+typedef LiteralSelection<false> OrderedResolution;
+typedef LiteralSelection<true> NegativeSelection;
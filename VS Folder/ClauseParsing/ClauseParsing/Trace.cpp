@@ -0,0 +1,221 @@
+// Trace.cpp : compact binary traces of proof runs
+//
+
+#include "stdafx.h"
+#include "Trace.h"
+
+using namespace std;
+
+// The buffer is written out once it holds this many bytes
+static const size_t TraceBufferSize = 1 << 20;
+
+bool ClauseTrace::Open(const string& fileName)
+{
+  file.open(fileName, ios::binary | ios::trunc);
+  if (!file)
+    return false;
+
+  buffer.reserve(TraceBufferSize + 64);
+  buffer.insert(buffer.end(), { 'C', 'L', 'T', 'R' });
+  Put(Version);
+  return true;
+}
+
+void ClauseTrace::Close()
+{
+  if (!file.is_open())
+    return;
+
+  file.write(buffer.data(), buffer.size());
+  buffer.clear();
+  file.close();
+}
+
+void ClauseTrace::AddExisting(const ClauseDatabase& db)
+{
+  for (int x = (int)numbers.size(); x < db.Size(); x++)
+    Added(db, x);
+}
+
+void ClauseTrace::Added(const ClauseDatabase& db, int id)
+{
+  if (!file.is_open())
+    return;
+
+  for (; atomsWritten < db.atoms.names.size(); atomsWritten++)
+  {
+    const string& name = db.atoms.names[atomsWritten];
+    buffer.push_back('a');
+    Put(name.size());
+    buffer.insert(buffer.end(), name.begin(), name.end());
+  }
+
+  const ClauseHeader& h = db.headers[id];
+  if (h.parents[0] < 0)
+    buffer.push_back('i');
+  else
+  {
+    buffer.push_back('r');
+    Put(clausesWritten - numbers[h.parents[0]]);
+    Put(clausesWritten - numbers[h.parents[1]]);
+  }
+  PutLiterals(db.Begin(id), db.End(id));
+
+  if (id >= numbers.size())
+    numbers.resize(id + 1, -1);
+  numbers[id] = clausesWritten++;
+
+  if (buffer.size() >= TraceBufferSize)
+  {
+    file.write(buffer.data(), buffer.size());
+    buffer.clear();
+  }
+}
+
+void ClauseTrace::Deleted(int id)
+{
+  if (!file.is_open() || id >= numbers.size() || numbers[id] < 0)
+    return;
+
+  buffer.push_back('d');
+  Put(numbers[id]);
+}
+
+void ClauseTrace::Remap(const vector<int>& newIds)
+{
+  vector<int> remapped;
+  for (int x = 0; x < newIds.size() && x < numbers.size(); x++)
+  {
+    if (newIds[x] < 0)
+    {
+      Deleted(x);
+      continue;
+    }
+    if (newIds[x] >= remapped.size())
+      remapped.resize(newIds[x] + 1, -1);
+    remapped[newIds[x]] = numbers[x];
+  }
+  numbers.swap(remapped);
+}
+
+void ClauseTrace::Put(uint64_t value)
+{
+  while (value >= 0x80)
+  {
+    buffer.push_back((char)(value | 0x80));
+    value >>= 7;
+  }
+  buffer.push_back((char)value);
+}
+
+void ClauseTrace::PutLiterals(const Literal* begin, const Literal* end)
+{
+  Put(end - begin);
+
+  Literal previous = 0;
+  for (const Literal* l = begin; l != end; l++)
+  {
+    Put(*l - previous);
+    previous = *l;
+  }
+}
+
+// Reads one varint at p, or returns false if the data ends inside it or it does not fit in 64 bits
+static bool Get(const char*& p, const char* end, uint64_t& value)
+{
+  value = 0;
+  for (int shift = 0; p != end && shift < 64; shift += 7)
+  {
+    unsigned char byte = (unsigned char)*p++;
+    value |= (uint64_t)(byte & 0x7f) << shift;
+    if ((byte & 0x80) == 0)
+      return true;
+  }
+  return false;
+}
+
+bool ReadTrace(const char* begin, const char* end, const string& name, ClauseDatabase& db, ostream& errors)
+{
+  const char* p = begin;
+  uint64_t version;
+  if (end - p < 4 || memcmp(p, "CLTR", 4) != 0)
+  {
+    errors << name << ": not a clause trace" << endl;
+    return false;
+  }
+  p += 4;
+  if (!Get(p, end, version) || version != ClauseTrace::Version)
+  {
+    errors << name << ": unsupported trace version" << endl;
+    return false;
+  }
+
+  vector<Literal> lits;
+  const char* problem = NULL;
+  while (p != end && problem == NULL)
+  {
+    char tag = *p++;
+    uint64_t a, b, count, value;
+
+    if (tag == 'a')
+    {
+      if (!Get(p, end, count) || count > (uint64_t)(end - p))
+        problem = "truncated atom name";
+      else
+      {
+        db.atoms.Intern(string_view(p, (size_t)count));
+        p += count;
+      }
+    }
+    else if (tag == 'i' || tag == 'r')
+    {
+      a = b = 0;
+      if (tag == 'r' && (!Get(p, end, a) || !Get(p, end, b)))
+        problem = "truncated resolvent";
+      else if (tag == 'r' && (a == 0 || b == 0 || a > (uint64_t)db.Size() || b > (uint64_t)db.Size()))
+        problem = "parent out of range";
+      else if (!Get(p, end, count) || count > (uint64_t)(end - p))
+        problem = "truncated clause";
+      else
+      {
+        lits.clear();
+        Literal previous = 0;
+        for (uint64_t x = 0; x < count && problem == NULL; x++)
+        {
+          if (!Get(p, end, value))
+            problem = "truncated clause";
+          else if ((x > 0 && value == 0) || previous + value >= 2 * db.atoms.names.size())
+            problem = "literal out of range";
+          else
+          {
+            previous += (Literal)value;
+            lits.push_back(previous);
+          }
+        }
+
+        if (problem == NULL)
+        {
+          int id = db.Size();
+          if (tag == 'r')
+            db.Add(lits, id - (int)a, id - (int)b);
+          else
+            db.Add(lits);
+        }
+      }
+    }
+    else if (tag == 'd')
+    {
+      if (!Get(p, end, value) || value >= (uint64_t)db.Size())
+        problem = "deleted clause out of range";
+    }
+    else
+      problem = "unknown record";
+  }
+
+  if (problem != NULL)
+  {
+    errors << name << ": " << problem << " at byte " << (p - begin) << endl;
+    return false;
+  }
+  return true;
+}
@@ -0,0 +1,70 @@
+// Trace.h : compact binary traces of proof runs
+//
+
+#pragma once
+
+#include "ClauseDatabase.h"
+
+// Streams every clause a run adds to a binary file as it goes, so a full derivation can be archived cheaply and
+// rendered as text later, off the search's hot path. The format is a byte stream in the spirit of binary DRAT:
+//
+//   "CLTR", then the format version
+//   'a' length name            the next atom, in the order the atoms were interned
+//   'i' count literals         an input clause
+//   'r' parent parent count literals
+//                              a resolvent
+//   'd' clause                 a clause that takes no further part, killed by a pop or evicted by a collection
+//
+// Every number is an unsigned LEB128 varint. Clauses are numbered from 0 in the order of their 'i' and 'r'
+// records; a parent is written as the distance back to it, and the sorted literals as the first one followed by
+// the gaps between them, so most numbers fit in one byte. Atom records always come before the first clause that
+// uses the atom.
+//
+// The trace numbers clauses in the order they were added. That is the database's numbering until a collection
+// renumbers the database (see Saturation::Collect); the trace keeps its own.
+struct ClauseTrace
+{
+public:
+  static const uint32_t Version = 1;
+
+  ClauseTrace() : atomsWritten(0), clausesWritten(0) {}
+  ~ClauseTrace() { Close(); }
+
+  // Creates fileName and writes the header. Returns false if it cannot be created.
+  bool Open(const std::string& fileName);
+
+  // Writes what is still buffered and closes the file
+  void Close();
+
+  bool IsOpen() const { return file.is_open(); }
+
+  // Records every clause already in db, for a trace attached after the input was read
+  void AddExisting(const ClauseDatabase& db);
+
+  // Records clause id of db, which was just added
+  void Added(const ClauseDatabase& db, int id);
+
+  // Records that clause id of the database is dead
+  void Deleted(int id);
+
+  // Follows a renumbering of the database. newIds maps every old id to its new one, or -1 if the clause was
+  // dropped; a dropped clause is recorded as deleted.
+  void Remap(const std::vector<int>& newIds);
+
+private:
+  std::ofstream file;
+  std::vector<char> buffer;
+  size_t atomsWritten;
+  int clausesWritten;
+
+  // The trace number of each database id
+  std::vector<int> numbers;
+
+  void Put(uint64_t value);
+  void PutLiterals(const Literal* begin, const Literal* end);
+};
+
+// Replays the trace in begin .. end into the empty database db, so clause n of the trace becomes clause n of db.
+// Deletions are skipped. Returns false, after reporting the problem on errors as "name: problem", if the trace is
+// malformed; the clauses before the problem are kept.
+bool ReadTrace(const char* begin, const char* end, const std::string& name, ClauseDatabase& db, std::ostream& errors);
@@ -0,0 +1,251 @@
+// UnitPropagator.cpp : unit propagation over the clause database with two watched literals
+//
+
+#include "stdafx.h"
+#include "UnitPropagator.h"
+
+using namespace std;
+
+UnitPropagator::UnitPropagator(ClauseDatabase& database, ClauseSet& clauses)
+  : db(database), seen(clauses), head(0)
+{
+}
+
+int UnitPropagator::Attach(int id)
+{
+  Grow();
+  if (watched.size() < 2 * db.Size())
+    watched.resize(2 * db.Size());
+
+  if (db.Length(id) == 0)
+    return id;
+
+  if (db.Length(id) == 1)
+    return Assign(*db.Begin(id), id);
+
+  // Watch the first two literals that are not false, or false ones if there are not enough of them
+  Literal w[2];
+  int open = 0;
+  bool satisfied = false;
+  for (const Literal* l = db.Begin(id); l != db.End(id) && open < 2; l++)
+  {
+    if (Value(*l) != -1)
+    {
+      satisfied = satisfied || Value(*l) == 1;
+      w[open++] = *l;
+    }
+  }
+
+  for (const Literal* l = db.Begin(id); open < 2; l++)
+  {
+    if (Value(*l) == -1)
+      w[open++] = *l;
+  }
+
+  watched[2 * id] = w[0];
+  watched[2 * id + 1] = w[1];
+  watches[w[0]].push_back(id);
+  watches[w[1]].push_back(id);
+
+  if (satisfied || Value(w[1]) != -1)
+    return -1;
+
+  // At most one literal is left, so the clause is already a unit or a conflict
+  int result = Strip(id);
+  if (db.Length(result) == 0)
+    return result;
+
+  derived.push_back(result);
+  return Assign(w[0], result);
+}
+
+int UnitPropagator::Propagate()
+{
+  while (head < trail.size())
+  {
+    Literal f = Complement(trail[head++]);
+    vector<int>& list = watches[f];
+
+    size_t keep = 0;
+    for (size_t x = 0; x < list.size(); x++)
+    {
+      int c = list[x];
+      Literal* w = &watched[2 * c];
+
+      // Clauses killed by a pop are dropped from the list for good
+      if (db.IsDead(c))
+        continue;
+
+      // Keep the literal that just became false in w[1]
+      if (w[0] == f)
+        swap(w[0], w[1]);
+
+      if (Value(w[0]) == 1)
+      {
+        list[keep++] = c;
+        continue;
+      }
+
+      // Look for another literal to watch in place of the false one
+      bool moved = false;
+      for (const Literal* l = db.Begin(c); l != db.End(c); l++)
+      {
+        if (*l != w[0] && *l != w[1] && Value(*l) != -1)
+        {
+          w[1] = *l;
+          watches[*l].push_back(c);
+          moved = true;
+          break;
+        }
+      }
+
+      if (moved)
+        continue;
+
+      list[keep++] = c;
+
+      int result = Strip(c);
+      if (db.Length(result) == 0)
+      {
+        // Leave the rest of the list as it was
+        for (x++; x < list.size(); x++)
+          list[keep++] = list[x];
+        list.resize(keep);
+        return result;
+      }
+
+      derived.push_back(result);
+      Assign(w[0], result);
+    }
+
+    list.resize(keep);
+  }
+
+  return -1;
+}
+
+void UnitPropagator::Pop()
+{
+  size_t keep = 0;
+  size_t redo = trail.size();
+  for (size_t x = 0; x < trail.size(); x++)
+  {
+    Literal l = trail[x];
+    if (!db.IsDead(reasons[AtomOf(l)]))
+    {
+      trail[keep++] = l;
+      continue;
+    }
+
+    values[l] = 0;
+    values[Complement(l)] = 0;
+    reasons[AtomOf(l)] = -1;
+    redo = min(redo, keep);
+  }
+
+  trail.resize(keep);
+  head = min(head, redo);
+
+  derived.erase(remove_if(derived.begin(), derived.end(), [this](int id) { return db.IsDead(id); }), derived.end());
+}
+
+void UnitPropagator::Roots(vector<bool>& keep) const
+{
+  for (size_t x = 0; x < trail.size(); x++)
+    keep[reasons[AtomOf(trail[x])]] = true;
+  for (size_t x = 0; x < derived.size(); x++)
+    keep[derived[x]] = true;
+}
+
+void UnitPropagator::Remap(const vector<int>& newIds)
+{
+  for (size_t x = 0; x < reasons.size(); x++)
+  {
+    if (reasons[x] >= 0)
+      reasons[x] = newIds[reasons[x]];
+  }
+  for (size_t x = 0; x < derived.size(); x++)
+    derived[x] = newIds[derived[x]];
+
+  // Dropped clauses stop being watched, which only costs propagation the units they would have given
+  vector<Literal> moved(watched.size());
+  for (size_t l = 0; l < watches.size(); l++)
+  {
+    vector<int>& list = watches[l];
+    size_t keep = 0;
+    for (size_t x = 0; x < list.size(); x++)
+    {
+      int id = newIds[list[x]];
+      if (id < 0)
+        continue;
+      moved[2 * id] = watched[2 * list[x]];
+      moved[2 * id + 1] = watched[2 * list[x] + 1];
+      list[keep++] = id;
+    }
+    list.resize(keep);
+  }
+  watched.swap(moved);
+}
+
+void UnitPropagator::Grow()
+{
+  size_t literals = 2 * db.atoms.names.size();
+  if (values.size() >= literals)
+    return;
+
+  values.resize(literals, 0);
+  watches.resize(literals);
+  reasons.resize(literals / 2, -1);
+}
+
+int UnitPropagator::Assign(Literal l, int reason)
+{
+  if (Value(l) == 1)
+  {
+    if (db.Level(reason) < db.Level(reasons[AtomOf(l)]))
+      reasons[AtomOf(l)] = reason;
+    return -1;
+  }
+
+  if (Value(l) == -1)
+  {
+    db.Resolve(reason, reasons[AtomOf(l)], resolvent);
+    int result = db.Add(resolvent, reason, reasons[AtomOf(l)]);
+    seen.Insert(db, result);
+    return result;
+  }
+
+  values[l] = 1;
+  values[Complement(l)] = -1;
+  reasons[AtomOf(l)] = reason;
+  trail.push_back(l);
+  return -1;
+}
+
+int UnitPropagator::Strip(int id)
+{
+  // Copy the literals out, since adding the intermediate clauses can move the pool
+  scratch.assign(db.Begin(id), db.End(id));
+
+  int current = id;
+  for (int x = 0; x < scratch.size(); x++)
+  {
+    if (Value(scratch[x]) != -1)
+      continue;
+
+    int unit = reasons[AtomOf(scratch[x])];
+    db.Resolve(current, unit, resolvent);
+
+    int existing = seen.Find(db, resolvent);
+    if (existing >= 0)
+    {
+      current = existing;
+      continue;
+    }
+
+    current = db.Add(resolvent, current, unit);
+    seen.Insert(db, current);
+  }
+
+  return current;
+}
@@ -0,0 +1,67 @@
+// UnitPropagator.h : unit propagation over the clause database with two watched literals
+//
+
+#pragma once
+
+#include "ClauseDatabase.h"
+
+// Propagates unit clauses to fixpoint. Every clause watches two of its literals that are not false, and is only
+// looked at again when one of them becomes false. A clause left with a single literal that is not false yields a
+// new unit, and one with none yields False.
+//
+// Propagation never leaves the resolution calculus: each derived clause is added to the database as a chain of
+// ordinary resolution steps against the unit clauses that falsified its other literals, so the proof printed by
+// PrintVector stays valid.
+struct UnitPropagator
+{
+public:
+  ClauseDatabase& db;
+  ClauseSet& seen;
+
+  // Ids of the unit clauses derived since the caller last cleared this
+  std::vector<int> derived;
+
+  UnitPropagator(ClauseDatabase& database, ClauseSet& clauses);
+
+  // Starts watching clause id. Returns the id of the False clause if the current units already refute it,
+  // otherwise -1.
+  int Attach(int id);
+
+  // Propagates every pending unit. Returns the id of the False clause on a conflict, otherwise -1.
+  int Propagate();
+
+  // Undoes every assignment whose unit clause died in the last ClauseDatabase::Pop. The other assignments stay,
+  // and the surviving trail from the first undone one on is propagated again by the next Propagate.
+  void Pop();
+
+  // Marks in keep every clause the current assignment rests on: the reasons and the derived units
+  void Roots(std::vector<bool>& keep) const;
+
+  // Follows a renumbering of the database. newIds maps every old id to its new one, or -1 if the clause was
+  // dropped, which must not happen to a root.
+  void Remap(const std::vector<int>& newIds);
+
+  // 1 if the literal is true, -1 if it is false, 0 if it is unassigned
+  int Value(Literal l) const { return l < values.size() ? values[l] : 0; }
+
+private:
+  std::vector<signed char> values;
+  std::vector<int> reasons;
+  std::vector<std::vector<int>> watches;
+  std::vector<Literal> watched;
+  std::vector<Literal> trail;
+  size_t head;
+  std::vector<Literal> scratch;
+  std::vector<Literal> resolvent;
+
+  // Sizes the per-literal tables for every atom in the database
+  void Grow();
+
+  // Makes l true because of unit clause reason. Returns the id of the False clause if l was already false.
+  // If l was already true the reason at the lower scope level is kept, so the assignment outlives more pops.
+  int Assign(Literal l, int reason);
+
+  // Resolves clause id against the unit clauses of all its false literals and returns the resulting clause,
+  // which is either a unit or False
+  int Strip(int id);
+};
@@ -5,19 +5,39 @@
 
 #pragma once
 
+#if defined(_WIN32)
 #include "targetver.h"
+#endif
 
 #include <stdio.h>
+#if defined(_WIN32)
 #include <tchar.h>
+#endif
 
+#include <climits>
+#include <cstdint>
+#include <cstring>
 #include <string>
+#include <string_view>
 #include <vector>
+#include <unordered_map>
+#include <algorithm>
 #include <queue>
+#include <functional>
 #include <iostream>
 #include <ostream>
+#include <iomanip>
 #include <fstream>
 #include <sstream>
 #include <iterator>
+#include <deque>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <chrono>
+#include <random>
 
 
 
@@ -0,0 +1,107 @@
+// LibraryTests.cpp : checks the library front ends against small knowledge bases whose answers are known
+//
+
+#include "stdafx.h"
+#include "Prover.h"
+#include "ClauseProver.h"
+#include "IncrementalProver.h"
+#include "ClauseReader.h"
+#include "CommandLine.h"
+
+using namespace std;
+
+static int wrong = 0;
+
+// Prints a check that went wrong, and counts it
+static void Check(const char* name, bool ok)
+{
+  if (!ok)
+  {
+    cout << "check failed: " << name << endl;
+    wrong++;
+  }
+}
+
+static void CheckClauseProver(const ProverOptions& options)
+{
+  ClauseProver consistent(options);
+  consistent.AddClauses("a\nb\n");
+  Check("consistent kb, clause query", consistent.Prove("a").status == Proved);
+  Check("consistent kb, unrelated query", consistent.Prove("c").status == NotProved);
+  Check("consistent kb, contradictory query", consistent.ProveFormula("p ^ ~p").status == NotProved);
+  Check("consistent kb, valid query", consistent.ProveFormula("p v ~p").status == Proved);
+
+  ClauseProver inconsistent(options);
+  inconsistent.AddClauses("a\n~a\n");
+  Check("inconsistent kb, contradictory query", inconsistent.ProveFormula("p ^ ~p").status == Proved);
+
+  ProverOptions badEngine = options;
+  badEngine.engine = "none";
+  Check("unknown engine", ClauseProver(badEngine).Prove("a").status == BadOptions);
+  ProverOptions badStrategy = options;
+  badStrategy.strategy = "none";
+  Check("unknown strategy", ClauseProver(badStrategy).Prove("a").status == BadOptions);
+}
+
+static void CheckIncrementalProver(const ProverOptions& options)
+{
+  // Push and pop: the rules' resolvent (~p r) is derived once at scope 0 and outlives the scope that needed it
+  IncrementalProver incremental(options);
+  vector<Literal> lits;
+  auto add = [&](const char* clause)
+  {
+    ParseClause(clause, clause + strlen(clause), incremental.db.atoms, lits);
+    incremental.Add(lits);
+  };
+  add("~p q");
+  add("~q r");
+  incremental.Push();
+  add("p");
+  add("~r");
+  Check("incremental, refuted in a scope", incremental.Prove() >= 0);
+  incremental.Pop();
+  Check("incremental, popped back to the rules", incremental.Prove() < 0);
+
+  ParseClause("~p r", "~p r" + 4, incremental.db.atoms, lits);
+  int kept = 0;
+  for (int x = 0; x < incremental.db.Size(); x++)
+  {
+    if (!incremental.db.IsDead(x) && equal(lits.begin(), lits.end(), incremental.db.Begin(x), incremental.db.End(x)))
+      kept++;
+  }
+  Check("incremental, rule resolvent kept", kept == 1);
+
+  incremental.Push();
+  add("p");
+  Check("incremental, satisfiable scope", incremental.Prove() < 0);
+  add("~r");
+  Check("incremental, refuted again", incremental.Prove() >= 0);
+  incremental.Pop();
+}
+
+int main(int argc, char *argv[])
+{
+  // Switches:
+  //   --engine=E, --threads=N, --bitset=0, --binary=0, --preprocess=0, --strategy=S, --order=O
+  //               run the checks with these settings, as for the prover
+  ProverOptions options;
+  for (int x = 1; x < argc; x++)
+  {
+    string arg = argv[x];
+    if (ReadOption(arg, "engine", options.engine) || ReadOption(arg, "threads", options.threads) || ReadOption(arg, "bitset", options.bitsets))
+      continue;
+    if (ReadOption(arg, "strategy", options.strategy) || ReadOption(arg, "order", options.order) || ReadOption(arg, "binary", options.binaryGraph))
+      continue;
+    if (ReadOption(arg, "preprocess", options.preprocess))
+      continue;
+
+    cerr << "Unknown argument " << arg << endl;
+    return 1;
+  }
+
+  CheckClauseProver(options);
+  CheckIncrementalProver(options);
+
+  cout << (wrong == 0 ? "all checks passed" : to_string(wrong) + " checks failed") << endl;
+  return wrong == 0 ? 0 : 1;
+}